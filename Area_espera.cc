@@ -6,45 +6,126 @@
 using namespace std;
 
 Area_espera::Area_espera() {
-
+    limite = 0;
+    auto_envio = false;
 }
 
 void Area_espera::add_job(const Proceso& p, const string& id_prior) {
-    map <string, Prioridad>::iterator it = mprior.find(id_prior);
-    if (it == mprior.end()) cout << "error: no existe prioridad" << endl;
+    unordered_map <string, map<string, Prioridad>::iterator>::iterator it = ids.find(id_prior);
+    if (it == ids.end()) cout << "error: no existe prioridad" << endl;
     else {
-        if (it->second.existe_job(p.consultar_ID())) cout << "error: ya existe proceso" << endl;
-        else it->second.add_job(p);
+        Prioridad& pri = it->second->second;
+        if (pri.existe_job(p.consultar_ID())) cout << "error: ya existe proceso" << endl;
+        else {
+            if (not pri.en_espera()) activas.insert(it->second);   //la prioridad pasa a tener trabajo
+            pri.add_job(p);
+        }
     }
     
 }
 
+void Area_espera::add_jobs(const vector<Proceso>& v, const string& id_prior) {
+    unordered_map <string, map<string, Prioridad>::iterator>::iterator it = ids.find(id_prior);
+    if (it == ids.end()) {
+        for (int i = 0; i < v.size(); ++i) cout << "error: no existe prioridad" << endl;
+    }
+    else {
+        Prioridad& pri = it->second->second;
+        pri.add_jobs(v);
+        if (pri.en_espera()) activas.insert(it->second);
+    }
+}
+
 void Area_espera::add_prior(const string& id_prior) {
-    if (mprior.find(id_prior) == mprior.end()) {
+    if (ids.find(id_prior) == ids.end()) {
         Prioridad p;
-        mprior.insert(make_pair(id_prior, p));
+        p.limitar(limite);
+        p.indexar(auto_envio);
+        ids[id_prior] = mprior.insert(make_pair(id_prior, p)).first;
     }
     else cout << "error: ya existe prioridad" << endl;
 }
 
 void Area_espera::eliminar_prior(const string& id_prior) {
-    map<string,Prioridad>::iterator it = mprior.find(id_prior);
-    if (it == mprior.end()) cout << "error: no existe prioridad" << endl;
+    unordered_map <string, map<string, Prioridad>::iterator>::iterator it = ids.find(id_prior);
+    if (it == ids.end()) cout << "error: no existe prioridad" << endl;
     else {
-        if (it->second.en_espera()) cout << "error: prioridad con procesos" << endl;
-        else mprior.erase(it);
+        if (it->second->second.en_espera()) cout << "error: prioridad con procesos" << endl;
+        else {          //una prioridad sin procesos no esta en el indice de activas
+            mprior.erase(it->second);
+            ids.erase(it);
+        }
     }
     
 }
 
 void Area_espera::enviar_job_a_cluster(int n, Cluster& c) {  
-    map <string, Prioridad>::iterator it = mprior.begin();
-    while (n > 0 and it != mprior.end()) {
-        it->second.enviar_proceso(n, c);
-        ++it;   
+    set <map<string, Prioridad>::iterator, Orden_prior>::iterator it = activas.begin();
+    while (n > 0 and it != activas.end()) {
+        (*it)->second.enviar_proceso(n, c);
+        if (not (*it)->second.en_espera()) activas.erase(it++);    //se ha vaciado: deja de estar activa
+        else ++it;   
+    }
+}
+
+void Area_espera::enviar_liberado(Cluster& c) {
+    int h = c.tomar_liberado();
+    if (not auto_envio) return;
+    if (c.max_hueco() < h) h = c.max_hueco();
+    set <map<string, Prioridad>::iterator, Orden_prior>::iterator it = activas.begin();
+    while (h > 0 and it != activas.end()) {
+        (*it)->second.despachar(h, c);
+        if (not (*it)->second.en_espera()) activas.erase(it++);
+        else ++it;
+    }
+}
+
+void Area_espera::modo_auto_envio(bool b) {
+    if (b and limite > 0) {         //despachar() recorre toda la cola, que ha de estar en memoria
+        cout << "error: modo limite espera activo" << endl;
+        return;
+    }
+    auto_envio = b;
+    for (map <string, Prioridad>::iterator it = mprior.begin(); it != mprior.end(); ++it) it->second.indexar(b);
+}
+
+void Area_espera::vaciar_espera(int t, Cluster& c, int& eventos) {
+    eventos = 0;
+    int lim = (c.consultar_tiempo() > INT_MAX - t) ? INT_MAX : c.consultar_tiempo() + t;
+    c.abrir_eventos();
+    enviar_job_a_cluster(INT_MAX, c);
+    c.tomar_liberado();         //lo liberado antes ya se ha intentado aprovechar
+    while (not activas.empty()) {
+        long long e = c.proximo_evento();
+        if (e == -1 or e > lim) break;         //nada más acabará antes del límite
+        if (c.avanzar_hasta(e) > 0) {           //sólo se reintenta si se ha liberado memoria
+            ++eventos;
+            if (auto_envio) enviar_liberado(c);
+            else enviar_job_a_cluster(INT_MAX, c);
+        }
+    }
+    if (not activas.empty()) c.avanzar_hasta(lim);
+    c.cerrar_eventos();
+}
+
+void Area_espera::enviar_job_a_federacion(int n, const vector<Cluster*>& v, int t) {
+    set <map<string, Prioridad>::iterator, Orden_prior>::iterator it = activas.begin();
+    while (n > 0 and it != activas.end()) {
+        (*it)->second.enviar_proceso(n, v, t);
+        if (not (*it)->second.en_espera()) activas.erase(it++);
+        else ++it;
     }
 }
 
+void Area_espera::limitar_espera(int n) {
+    if (n > 0 and auto_envio) {
+        cout << "error: modo auto envio activo" << endl;
+        return;
+    }
+    limite = n;
+    for (map <string, Prioridad>::iterator it = mprior.begin(); it != mprior.end(); ++it) it->second.limitar(n);
+}
+
 void Area_espera::leer() {
     int n;
     string s;
@@ -52,7 +133,9 @@ void Area_espera::leer() {
     for (int i = 0; i < n; ++i) {
         cin >> s;
         Prioridad pri;
-        mprior.insert(make_pair(s, pri));
+        pri.limitar(limite);
+        pri.indexar(auto_envio);
+        ids[s] = mprior.insert(make_pair(s, pri)).first;
     }
 }
 
@@ -64,17 +147,72 @@ void Area_espera::escribir() const {
 
 }
 
+long long Area_espera::num_procesos() const {
+    long long n = 0;
+    for (map <string, Prioridad>::const_iterator it = mprior.begin(); it != mprior.end(); ++it) n += it->second.num_procesos();
+    return n;
+}
+
+void Area_espera::instantanea(Instantanea& s) const {
+    s.resize(mprior.size());
+    int i = 0;
+    for (map <string, Prioridad>::const_iterator it = mprior.begin(); it != mprior.end(); ++it, ++i) {
+        s[i].first = it->first;
+        it->second.instantanea(s[i].second);
+    }
+}
+
+void Area_espera::escribir(ostream& os, const Instantanea& s) {
+    for (int i = 0; i < s.size(); ++i) {
+        os << s[i].first << '\n';
+        Prioridad::escribir(os, s[i].second);
+    }
+}
+
 void Area_espera::escribir_prior(const string& id_prior, map <string, Prioridad>::const_iterator& it) const {
     if (id_prior != "*") {      //la llamada viene del comando imprimir prioridad(hay que buscar it con id_prior)
-        it = mprior.find(id_prior);
-        if (it == mprior.end()) cout << "error: no existe prioridad" << endl;
+        unordered_map <string, map<string, Prioridad>::iterator>::const_iterator iti = ids.find(id_prior);
+        if (iti == ids.end()) cout << "error: no existe prioridad" << endl;
         else {
-            if (it->second.en_espera()) it->second.escribir_job(); 
-            it->second.escribir_env_rech();
+            it = iti->second;
+            it->second.escribir();
         }
     }
-    else {      //la llamada viene del comando escribir area de espera (el iterador ya esta inicializado)
-        if (it->second.en_espera()) it->second.escribir_job(); 
-        it->second.escribir_env_rech();
+    else it->second.escribir();     //la llamada viene del comando escribir area de espera (el iterador ya esta inicializado)
+}
+
+void Area_espera::escribir_espera(const string& id_prior) const {
+    unordered_map <string, map<string, Prioridad>::iterator>::const_iterator it = ids.find(id_prior);
+    if (it == ids.end()) cout << "error: no existe prioridad" << endl;
+    else it->second->second.escribir_espera();
+}
+
+void Area_espera::escribir_cambios() {
+    for (map <string, Prioridad>::iterator it = mprior.begin(); it != mprior.end(); ++it) {
+        if (it->second.con_cambios()) {
+            cout << it->first << endl;
+            it->second.escribir_cambios();
+        }
+    }
+}
+
+int Area_espera::comprobar_invariantes() const {
+    int fallos = 0;
+    if (ids.size() != mprior.size()) {
+        cout << "error: invariante espera ids" << endl;
+        ++fallos;
+    }
+    for (map<string, Prioridad>::const_iterator it = mprior.begin(); it != mprior.end(); ++it) {
+        fallos += it->second.comprobar(it->first);
+        unordered_map<string, map<string, Prioridad>::iterator>::const_iterator j = ids.find(it->first);
+        if (j == ids.end() or j->second->first != it->first) {
+            cout << "error: invariante " << it->first << " ids" << endl;
+            ++fallos;
+        }
+        else if (it->second.en_espera() and activas.count(j->second) == 0) {
+            cout << "error: invariante " << it->first << " activas" << endl;
+            ++fallos;
+        }
     }
+    return fallos;
 }
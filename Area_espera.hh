@@ -14,6 +14,9 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <climits>
 #endif
 
 /** @class Area_espera
@@ -22,10 +25,39 @@
 
 class Area_espera {
 
+public:
+    /** @brief Copia de sólo lectura de las prioridades: id y copia de cada una */
+    typedef vector<pair<string, Prioridad::Instantanea> > Instantanea;
+
 private:
     /** @brief Mapa de prioridades ordenado lexicográficamente por su id */
     map <string, Prioridad> mprior;
 
+    /** @brief Orden lexicográfico de los iteradores de mprior según su id */
+    struct Orden_prior {
+        bool operator()(const map<string, Prioridad>::iterator& a,
+                        const map<string, Prioridad>::iterator& b) const {
+            return a->first < b->first;
+        }
+    };
+
+    /** @brief Tabla de identificadores internados: id de prioridad -> posición en mprior
+
+      Igual que activas, guarda iteradores de mprior: por eso el p.i. no se puede copiar */
+    unordered_map <string, map<string, Prioridad>::iterator> ids;
+
+    /** @brief Índice de las prioridades con procesos pendientes, en el orden de mprior */
+    set <map<string, Prioridad>::iterator, Orden_prior> activas;
+
+    /** @brief Máximo de procesos en memoria por parte de cola de cada prioridad (0 = sin límite) */
+    int limite;
+
+    /** @brief Indica si los procesos pendientes se envían al cluster cuando se libera memoria */
+    bool auto_envio;
+
+    Area_espera(const Area_espera&) = delete;
+    Area_espera& operator=(const Area_espera&) = delete;
+
 public:
     //Constructoras
 
@@ -44,15 +76,25 @@ public:
      
       \pre <em>cierto</em>
       \post El resultado es el p.i. más el proceso p con el ID de proridad = id_prior
-      \coste Logarítmico sobre coste logarítmico
+      \coste Constante en promedio (tabla de ids) más logarítmico (add_job de Prioridad)
   */
     void add_job(const Proceso& p, const string& id_prior);
 
+    /** @brief Añade un bloque de procesos a una prioridad del área de espera
+
+      \pre <em>cierto</em>
+      \post Si existe la prioridad con ID = id_prior, el resultado es el p.i. más los
+      procesos de v no repetidos en ella (consultar add_jobs() de la clase Prioridad);
+      en caso contrario se ha escrito un mensaje de error por cada proceso de v
+      \coste Constante en promedio (tabla de ids) más el coste de add_jobs() de Prioridad
+  */
+    void add_jobs(const vector<Proceso>& v, const string& id_prior);
+
     /** @brief Añade una prioridad al área de espera
      
       \pre <em>cierto</em>
       \post El resultado es el p.i. más la prioridad con id_prior
-      \coste Logarítmico (búsqueda del elemento en el árbol de búsqueda binario interno)
+      \coste Logarítmico (inserción en el árbol de búsqueda binario interno)
   */
     void add_prior(const string& id_prior);
 
@@ -60,7 +102,7 @@ public:
      
         \pre Existe una prioridad en el p.i. con ID de prioridad = id_prior
         \post El p.i. contiene sus prioridades originales menos la prioridad con ID de prioridad = id_prior
-        \coste Logarítmico (búsqueda del elemento en el árbol de búsqueda binario interno)
+        \coste Constante en promedio (tabla de ids) más logarítmico (borrado del mapa)
     */
     void eliminar_prior(const string& id_prior);
 
@@ -68,13 +110,97 @@ public:
      
         \pre n > 0
         \post El p.i. ha intentado enviar n procesos al cluster c, los aceptados
-        son elimindas del p.i., los rechazados vuelven al p.i. como nuevos
-        \coste Lineal sobre lineal (consultar coste de la función en_proceso()
-        de la clase Prioridad)
+        son elimindas del p.i., los rechazados vuelven al p.i. como nuevos.
+        Sólo se visitan las prioridades con procesos pendientes
+        \coste Lineal respecto al número de prioridades activas visitadas sobre lineal
+        (consultar coste de la función enviar_proceso() de la clase Prioridad)
     */
     void enviar_job_a_cluster(int n, Cluster& c);
 
+    /** @brief Envía los procesos pendientes que caben en la memoria liberada del cluster
+
+        \pre <em>cierto</em>
+        \post Se ha consultado y olvidado la memoria liberada de c (consultar
+        tomar_liberado() de la clase Cluster). Si está activado el envío automático y
+        algún procesador ha perdido procesos, con h su mayor hueco, se han intentado
+        enviar por orden de prioridad y de antigüedad sólo los procesos pendientes de
+        memoria <= h (consultar
+        despachar() de la clase Prioridad); si no, el p.i. no cambia
+        \coste Constante si no se ha liberado memoria; si no, lineal respecto a las
+        prioridades activas más el coste de despachar() de cada una
+    */
+    void enviar_liberado(Cluster& c);
+
+    /** @brief Activa o desactiva el envío automático de procesos
+
+        \pre <em>cierto</em>
+        \post Si b y el p.i. tiene límite (consultar limitar_espera()), se ha escrito un
+        error y el p.i. no cambia. Si no, si b, enviar_liberado() envía procesos al
+        cluster y vaciar_espera() sólo envía los que caben en la memoria liberada, y
+        todas las prioridades, y las que se añadan después, tienen índice por memoria
+        (consultar indexar() de la clase Prioridad); si no, no
+        \coste Lineal respecto al número de procesos pendientes si cambia
+    */
+    void modo_auto_envio(bool b);
+
+    /** @brief Ejecuta la simulación hasta vaciar el área de espera
+
+        \pre t > 0
+        \post Se han repetido envíos de todos los procesos pendientes al cluster c
+        (como enviar_job_a_cluster()) y avances de tiempo hasta la siguiente finalización
+        de algún proceso (con el envío automático, tras cada avance sólo se envían
+        los procesos que caben en la memoria liberada), hasta que el p.i. queda vacío o la siguiente finalización es
+        posterior al reloj inicial más t; en este caso, o si ya no quedan procesos en
+        ejecución, el reloj de c acaba en el reloj inicial más t. eventos es el número
+        de instantes con finalizaciones recorridos
+        \coste Por cada instante con finalizaciones, el de enviar_job_a_cluster() más
+        el de avanzar_hasta() de la clase Cluster; más lineal respecto al número de
+        procesos y procesadores del cluster (al empezar y al acabar)
+    */
+    void vaciar_espera(int t, Cluster& c, int& eventos);
+
+    /** @brief Intenta enviar una cantidad de procesos del área de espera a un conjunto de clusters
+
+        \pre n > 0, t es el instante actual del p.i.
+        \post Como enviar_job_a_cluster(), pero cada proceso se ofrece al cluster de v
+        en el que mejor cabe según su resumen (consultar enviar_proceso() de la clase
+        Prioridad)
+        \coste Lineal respecto al número de prioridades activas visitadas sobre el
+        coste de enviar_proceso() de la clase Prioridad
+    */
+    void enviar_job_a_federacion(int n, const vector<Cluster*>& v, int t);
+
+    /** @brief Fija el máximo de procesos en memoria de las prioridades
+
+        \pre n >= 0
+        \post Si n > 0 y está activado el envío automático, se ha escrito un error y
+        el p.i. no cambia. Si no, todas las prioridades del p.i., y las que se añadan
+        después, tienen como límite n (consultar limitar() de la clase Prioridad)
+        \coste Lineal respecto al número de procesos pendientes del p.i.
+    */
+    void limitar_espera(int n);
+
     //Consultoras
+
+    /** @brief Comprueba los invariantes del área de espera
+
+        \pre <em>cierto</em>
+        \post Se han comprobado los invariantes de cada prioridad (consultar
+        comprobar() de la clase Prioridad), la tabla de ids y que toda prioridad con
+        procesos pendientes está en activas; por cada uno que no se cumple se ha
+        escrito una línea "error: invariante <id_prior> <qué>". El resultado es cuántos fallan
+        \coste Lineal respecto al número de procesos pendientes en memoria más el
+        número de prioridades por logarítmico
+    */
+    int comprobar_invariantes() const;
+
+    /** @brief Consultora del número de procesos pendientes
+
+      \pre <em>cierto</em>
+      \post El resultado es el número de procesos pendientes de todas las prioridades
+      \coste Lineal respecto al número de prioridades
+    */
+    long long num_procesos() const;
     
     //Lectura y escritura
 
@@ -96,15 +222,53 @@ public:
     */
     void escribir() const; //utiliza la operación "escribir_proc" para todas la id_prior
 
+    /** @brief Toma una copia de sólo lectura de todas las prioridades
+
+      \pre <em>cierto</em>
+      \post s permite escribir lo mismo que escribir() en el estado actual del p.i.
+      \coste Lineal respecto al número de prioridades más el de instantanea() de
+      cada una (consultar la clase Prioridad)
+    */
+    void instantanea(Instantanea& s) const;
+
+    /** @brief Operación de escritura de una copia del área de espera
+
+      \pre s es el resultado de instantanea()
+      \post Se ha escrito en os lo que escribía escribir() al tomar s
+      \coste Lineal respecto al tamaño del texto
+    */
+    static void escribir(ostream& os, const Instantanea& s);
+
+    /** @brief Operación de escritura de las prioridades que han cambiado
+
+      \pre <em>cierto</em>
+      \post Se han escrito, como en escribir(), sólo las prioridades que han cambiado
+      desde la anterior llamada a esta operación (o desde su creación), que dejan
+      de tener cambios pendientes
+      \coste Lineal respecto al número de prioridades más lineal respecto al número
+      de procesos de las prioridades escritas
+    */
+    void escribir_cambios();
+
     /** @brief Operación de escritura de todos los procesos de una prioridad especifica
 
       \pre Existe una prioridad con ID = id_prior en el p.i.
       \post Se ha escrito todos los procesos pendientes con la prioridad id_prior   
         por orden decreciente de antigüedad en el canal standard de salida. 
       \coste Lineal respecto al número de procesos de la prioridad escrita,
-      más logarítmico (búsqueda en el mapa)
+      más constante en promedio (búsqueda en la tabla de ids)
     */
     void escribir_prior(const string& id_prior,map <string, Prioridad>::const_iterator& it) const; //escribe todos los procesos pendeintes con esta id_prior
 
+    /** @brief Operación de escritura de las estadísticas de espera de una prioridad
+
+      \pre <em>cierto</em>
+      \post Si existe una prioridad con ID = id_prior en el p.i. se han escrito sus
+      estadísticas de tiempo de espera en el canal standard de salida, en caso
+      contrario se ha escrito un mensaje de error
+      \coste Constante en promedio (búsqueda en la tabla de ids)
+    */
+    void escribir_espera(const string& id_prior) const;
+
 };
 #endif
\ No newline at end of file
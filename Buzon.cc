@@ -0,0 +1,73 @@
+/** @file Buzon.cc
+    @brief Código de la clase Buzon
+*/
+
+#include "Buzon.hh"
+
+Buzon::Buzon() {
+    Nodo* n = new Nodo;         //nodo centinela: la cola nunca está vacía
+    n->sig.store(nullptr, memory_order_relaxed);
+    cabeza.store(n, memory_order_relaxed);
+    cola = n;
+}
+
+Buzon::~Buzon() {
+    while (cola != nullptr) {
+        Nodo* sig = cola->sig.load(memory_order_relaxed);
+        delete cola;
+        cola = sig;
+    }
+}
+
+void Buzon::depositar(Nodo* n) {
+    n->sig.store(nullptr, memory_order_relaxed);
+    Nodo* ant = cabeza.exchange(n, memory_order_acq_rel);     //a partir de aquí n es el último
+    ant->sig.store(n, memory_order_release);                   //el consumidor ya puede llegar a n
+}
+
+void Buzon::alta_proceso(const Proceso& p, const string& id_prior) {
+    Nodo* n = new Nodo;
+    n->tipo = ALTA_PROCESO;
+    n->id_prior = id_prior;
+    n->p = p;
+    depositar(n);
+}
+
+void Buzon::alta_prioridad(const string& id_prior) {
+    Nodo* n = new Nodo;
+    n->tipo = ALTA_PRIORIDAD;
+    n->id_prior = id_prior;
+    depositar(n);
+}
+
+void Buzon::baja_prioridad(const string& id_prior) {
+    Nodo* n = new Nodo;
+    n->tipo = BAJA_PRIORIDAD;
+    n->id_prior = id_prior;
+    depositar(n);
+}
+
+int Buzon::drenar(Area_espera& ae, int ahora, int max) {
+    int i = 0;
+    while (i < max) {
+        Nodo* sig = cola->sig.load(memory_order_acquire);
+        if (sig == nullptr) return i;       //no hay más peticiones (o la siguiente aún se está depositando)
+        delete cola;
+        cola = sig;                 //sig pasa a ser el centinela una vez aplicada su petición
+        if (sig->tipo == ALTA_PROCESO) {        //misma cabecera que el comando equivalente
+            sig->p.fijar_entrada(ahora);
+            cout << "#ape " << sig->id_prior << ' ' << sig->p.consultar_ID() << endl;
+            ae.add_job(sig->p, sig->id_prior);
+        }
+        else if (sig->tipo == ALTA_PRIORIDAD) {
+            cout << "#ap " << sig->id_prior << endl;
+            ae.add_prior(sig->id_prior);
+        }
+        else {
+            cout << "#bp " << sig->id_prior << endl;
+            ae.eliminar_prior(sig->id_prior);
+        }
+        ++i;
+    }
+    return i;
+}
@@ -0,0 +1,114 @@
+/** @file Buzon.hh
+    @brief Especificación de la clase Buzon
+*/
+
+#ifndef BUZON_HH
+#define BUZON_HH
+
+#include "Proceso.hh"
+#include "Area_espera.hh"
+#ifndef NO_DIAGRAM
+#include <atomic>
+#include <string>
+#endif
+using namespace std;
+
+/** @class Buzon
+    @brief Cola de peticiones para el área de espera con varios productores y un consumidor
+
+    Cualquier hilo puede depositar peticiones (alta de un proceso en espera, alta o
+    baja de una prioridad) sin bloquearse: cada depósito es un único intercambio
+    atómico. Un solo hilo, el que ejecuta la simulación, las aplica al área de espera
+    en orden de llegada entre comando y comando.
+*/
+class Buzon {
+
+private:
+    /** @brief Tipos de petición */
+    enum Tipo { ALTA_PROCESO, ALTA_PRIORIDAD, BAJA_PRIORIDAD };
+
+    /** @brief Nodo de la cola con una petición */
+    struct Nodo {
+        atomic<Nodo*> sig;
+        Tipo tipo;
+        string id_prior;
+        Proceso p;
+    };
+
+    /** @brief Último nodo depositado (lo modifican los productores) */
+    atomic<Nodo*> cabeza;
+
+    /** @brief Nodo ya consumido que precede a la primera petición pendiente (sólo lo usa el consumidor) */
+    Nodo* cola;
+
+    /** @brief Deposita un nodo al final de la cola
+        \pre n no está en la cola
+        \post n es la última petición de la cola
+        \coste Constante (un intercambio atómico)
+    */
+    void depositar(Nodo* n);
+
+    Buzon(const Buzon&) = delete;
+    Buzon& operator=(const Buzon&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un buzón sin peticiones
+        \coste Constante
+    */
+    Buzon();
+
+    /** @brief Destructora.
+
+        \pre Ningún hilo está depositando peticiones
+        \post Se han liberado las peticiones pendientes
+        \coste Lineal respecto al número de peticiones pendientes
+    */
+    ~Buzon();
+
+    //Modificadoras (seguras desde cualquier hilo)
+
+    /** @brief Pide dar de alta un proceso en una prioridad
+
+        \pre <em>cierto</em>
+        \post La petición queda pendiente de aplicar con add_job() del área de espera
+        \coste Constante
+    */
+    void alta_proceso(const Proceso& p, const string& id_prior);
+
+    /** @brief Pide dar de alta una prioridad
+
+        \pre <em>cierto</em>
+        \post La petición queda pendiente de aplicar con add_prior() del área de espera
+        \coste Constante
+    */
+    void alta_prioridad(const string& id_prior);
+
+    /** @brief Pide dar de baja una prioridad
+
+        \pre <em>cierto</em>
+        \post La petición queda pendiente de aplicar con eliminar_prior() del área de espera
+        \coste Constante
+    */
+    void baja_prioridad(const string& id_prior);
+
+    //Modificadoras (sólo desde el hilo de la simulación)
+
+    /** @brief Aplica las peticiones pendientes al área de espera
+
+        \pre max > 0; sólo un hilo llama a esta operación
+        \post Se han aplicado a ae, en orden de llegada, como mucho max peticiones
+        completamente depositadas (los procesos entran en espera en el instante ahora);
+        por cada una se ha escrito en el canal standard de salida lo mismo que su
+        comando equivalente (ape, ap o bp), cabecera incluida, de modo que la salida
+        es la de una entrada con esos comandos intercalados; devuelve cuántas se han
+        aplicado
+        \coste Lineal respecto al número de peticiones aplicadas por el coste de cada una
+    */
+    int drenar(Area_espera& ae, int ahora, int max);
+};
+#endif
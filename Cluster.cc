@@ -3,39 +3,571 @@
 */
 
 #include "Cluster.hh"
+#include "Contadores.hh"
+#include "Perfil.hh"
 using namespace std;
 
 Cluster::Cluster() {
-
+    reloj = 0;
+    hilos = 1;
+    con_tabla = true;
+    ambito = -1;
+    comp_parcial = false;
+    n_parcial = 0;
+    movido.first = movido.second = 0;
+    desplazados.first = desplazados.second = 0;
+    rebal = false;
+    n_rebal = 0;
+    acept.recibidos = acept.aceptados = acept.rescatados = 0;
+    migrado.first = 0;
+    migrado.second = 0;
+    espec = 0;
+    eventos = false;
+    mesp.procesos = mesp.directos = mesp.corregidos = mesp.recalculados = mesp.rondas = 0;
 }
 
 bool Cluster::recibir_job(const Proceso& p) {   
+    if (ambito != -1) return recibir_job_ambito(p);
+    ++acept.recibidos;
     map<string, Procesador>::iterator it = mprc.end();
-    bfs(it, Tprc, p.consultar_MEM(), p.consultar_ID());
+    bfs(it, p.consultar_MEM(), p.consultar_ID());
+    if (it == mprc.end() and comp_parcial) {   //el proceso no cabia en ningun hueco
+        int coste;
+        bfs_parcial(it, p.consultar_MEM(), p.consultar_ID(), coste);
+        if (it != mprc.end()) {
+            int procs;
+            movido.second += it->second.coste_compactar(procs);
+            desplazados.second += procs;
+            movido.first += it->second.compactar_parcial(p.consultar_MEM(), procs);
+            desplazados.first += procs;
+            ++n_parcial;
+        }
+    }
+    if (it == mprc.end() and rebal) {          //se intenta juntar memoria libre migrando procesos
+        int movs, antes, despues;
+        long long bytes;
+        if (eventos) sincronizar();             //los procesos migrados llevan su tiempo restante
+        if (rebalancear(p.consultar_MEM(), p.consultar_ID(), movs, bytes, antes, despues)) {
+            if (eventos) for (int i = 0; i < orden.size(); ++i) planificar(i);
+            bfs(it, p.consultar_MEM(), p.consultar_ID());
+            if (it != mprc.end()) ++acept.rescatados;
+        }
+    }
     if (it == mprc.end()) return false;        //el proceso no cabia en ningun procesador
-    it->second.add_job(p);
+    colocar(nodo[it->first], p);
+    ++acept.aceptados;
+    return true;
+}
+
+void Cluster::colocar(int m, const Proceso& p) {
+    if (eventos and base[m] != reloj) {     //los tiempos de m aún están referidos a base[m]
+        Proceso q = p;
+        q.restar_tiempo(base[m] - reloj);
+        orden[m]->second.add_job(q);
+    }
+    else orden[m]->second.add_job(p);
+    if (eventos) planificar(m);
+    actualizar(m);
+}
+
+void Cluster::planificar(int m) {
+    if (plazo[m] != -1) plazos.erase(make_pair(plazo[m], m));
+    int f = orden[m]->second.proximo_fin();
+    if (f == INT_MAX) plazo[m] = -1;
+    else {
+        plazo[m] = base[m] + (long long)max(f, 1);      //un proceso sin tiempo acaba en el siguiente instante, como con at
+        plazos.insert(make_pair(plazo[m], m));
+    }
+}
+
+void Cluster::anotar_liberado(int m, int antes) {
+    if (orden[m]->second.num_procesos() < antes and not en_liberados[m]) {
+        en_liberados[m] = true;
+        liberados.push_back(m);
+    }
+}
+
+int Cluster::tomar_liberado() {
+    int h = 0;
+    for (int i = 0; i < liberados.size(); ++i) {
+        int m = liberados[i];
+        h = max(h, orden[m]->second.max_hueco());
+        en_liberados[m] = false;
+    }
+    liberados.clear();
+    return h;
+}
+
+int Cluster::max_hueco() const {
+    return agg.empty() ? 0 : agg[0].max_hueco;
+}
+
+long long Cluster::memoria_libre() const {
+    return agg.empty() ? 0 : agg[0].libre;
+}
+
+int Cluster::num_procesadores() const {
+    return mprc.size();
+}
+
+bool Cluster::resumen_prc(const string& id, int& procesos, int& huecos) const {
+    map<string, Procesador>::const_iterator it = mprc.find(id);
+    if (it == mprc.end()) return false;
+    vector<int> v;
+    it->second.consultar_huecos(v);
+    procesos = it->second.num_procesos();
+    huecos = v.size();
+    return true;
+}
+
+void Cluster::adelantar(int m) {
+    if (base[m] != reloj) {
+        if (reg) reg->fijar_tiempo(base[m]);       //las finalizaciones se registran respecto a base[m]
+        int antes = orden[m]->second.num_procesos();
+        orden[m]->second.avanzar_tiempo(reloj - base[m]);
+        anotar_liberado(m, antes);
+        if (reg) reg->fijar_tiempo(reloj);
+        base[m] = reloj;
+    }
+    planificar(m);
+}
+
+void Cluster::sincronizar() {
+    for (int i = 0; i < orden.size(); ++i) {
+        if (base[i] != reloj) adelantar(i);
+    }
+}
+
+void Cluster::abrir_eventos() {
+    eventos = true;
+    base.assign(orden.size(), reloj);
+    plazo.assign(orden.size(), -1);
+    plazos.clear();
+    for (int i = 0; i < orden.size(); ++i) planificar(i);
+}
+
+int Cluster::avanzar_hasta(int t) {
+    int acabados = 0;
+    while (not plazos.empty() and plazos.begin()->first <= t) {
+        int m = plazos.begin()->second;
+        reloj = plazos.begin()->first;
+        int antes = orden[m]->second.num_procesos();
+        adelantar(m);
+        acabados += antes - orden[m]->second.num_procesos();
+        actualizar(m);
+    }
+    reloj = t;
+    if (reg) reg->fijar_tiempo(reloj);
+    return acabados;
+}
+
+void Cluster::cerrar_eventos() {
+    sincronizar();
+    eventos = false;
+    base.clear();
+    plazo.clear();
+    plazos.clear();
+}
+
+bool Cluster::avanzar_evento() {
+    abrir_eventos();
+    bool hay = not plazos.empty();
+    while (not plazos.empty() and avanzar_hasta(plazos.begin()->first) == 0);   //los plazos pueden ser cotas inferiores
+    cerrar_eventos();
+    return hay;
+}
+
+long long Cluster::proximo_evento() const {
+    return plazos.empty() ? -1 : plazos.begin()->first;
+}
+
+void Cluster::modo_rebalanceo(bool b) {
+    rebal = b;
+}
+
+void Cluster::modo_registro(const string& fich) {
+    for (map<string, Procesador>::iterator it = mprc.begin(); it != mprc.end(); ++it) it->second.fijar_registro(nullptr);
+    reg.reset();                //espera a que se escriban los eventos pendientes
+    if (fich != "-") {
+        FILE* f = fopen(fich.c_str(), "w");
+        if (f == nullptr) cout << "error: no se puede abrir fichero" << endl;
+        else {
+            reg = make_shared<Registro>(f);
+            reg->fijar_tiempo(reloj);
+            for (map<string, Procesador>::iterator it = mprc.begin(); it != mprc.end(); ++it) it->second.fijar_registro(reg.get());
+        }
+    }
+}
+
+bool Cluster::mas_memoria(const Proceso& a, const Proceso& b) {
+    return a.consultar_MEM() > b.consultar_MEM();
+}
+
+bool Cluster::rebalancear(int memo, int id, int& movs, long long& bytes, int& antes, int& despues) {
+    Perfil::Tramo tr("Cluster::rebalancear");
+    movs = 0;
+    bytes = 0;
+    antes = 0;
+    for (int i = 0; i < orden.size(); ++i) {
+        ++Contadores::bfs;
+        if (orden[i]->second.max_hueco() > antes) antes = orden[i]->second.max_hueco();
+    }
+    despues = antes;
+    int falta = (memo > 0) ? memo : antes + 1;      //hueco que ha de abrir el rebalanceo
+
+    //objetivo: un procesador sin hueco de falta que lo tendría sin sus procesos y del
+    //que puede salir lo necesario hacia la memoria libre de los demás
+    int obj = -1;
+    long long mover = 0;        //memoria que como mínimo ha de salir del objetivo
+    int cap = 0;                //memoria del objetivo
+    for (int i = 0; i < orden.size(); ++i) {
+        ++Contadores::bfs;
+        const Procesador& prc = orden[i]->second;
+        int c = prc.MEM_max();
+        int ocu = prc.MEM_ocupada();
+        if (c >= falta and prc.max_hueco() < falta) {
+            long long m = (memo == 0) ? ocu : max(0, ocu - (c - falta));     //sin proceso pendiente se migra todo lo posible
+            if (m <= agg[0].libre - (c - ocu) and (obj == -1 or (memo > 0 and (m < mover or (m == mover and c > cap)))
+                or (memo == 0 and (c > cap or (c == cap and m < mover))))) {
+                obj = i;
+                mover = m;
+                cap = c;
+            }
+        }
+    }
+    if (obj == -1) return false;        //ninguna consolidación abre el hueco: no se recorren huecos
+
+    //plan: procesos del objetivo, de mayor a menor memoria (antes el de id, que ha de salir), al
+    //hueco más ajustado de otro procesador, hasta que el proceso pendiente quepa en el objetivo
+    Procesador& prc = orden[obj]->second;
+    vector<Proceso> v;
+    prc.consultar_procesos(v);
+    stable_sort(v.begin(), v.end(), mas_memoria);
+    bool queda_id = memo > 0 and prc.existe_job(id);
+    for (int j = 0; queda_id and j < v.size(); ++j) {
+        if (v[j].consultar_ID() == id) rotate(v.begin(), v.begin() + j, v.begin() + j + 1);
+    }
+    multiset<pair<int, int> > huecos;       //(tamaño, posición en orden) de los demás procesadores
+    vector<int> h;
+    for (int i = 0; i < orden.size(); ++i) {
+        ++Contadores::bfs;
+        if (i != obj) {
+            orden[i]->second.consultar_huecos(h);
+            for (int j = 0; j < h.size(); ++j) huecos.insert(make_pair(h[j], i));
+        }
+    }
+    int ocupada = prc.MEM_ocupada();
+    vector<pair<int, int> > plan;          //(proceso de v, posición en orden del destino)
+    for (int j = 0; j < v.size() and (memo == 0 or queda_id or prc.MEM_max() - ocupada < falta); ++j) {
+        int mem = v[j].consultar_MEM();
+        multiset<pair<int, int> >::iterator it = huecos.lower_bound(make_pair(mem, -1));
+        while (it != huecos.end() and orden[it->second]->second.existe_job(v[j].consultar_ID())) ++it;
+        if (it != huecos.end()) {
+            plan.push_back(make_pair(j, it->second));
+            pair<int, int> resto(it->first - mem, it->second);
+            huecos.erase(it);
+            if (resto.first > 0) huecos.insert(resto);
+            ocupada -= mem;
+            if (v[j].consultar_ID() == id) queda_id = false;
+        }
+        else if (j == 0 and queda_id) break;    //el de id no puede salir
+    }
+    int hueco = prc.MEM_max() - ocupada;
+    despues = hueco;
+    if (not huecos.empty() and huecos.rbegin()->first > despues) despues = huecos.rbegin()->first;
+    if (memo > 0 ? (hueco < falta or queda_id) : despues <= antes) {     //el plan no abre el hueco: no se migra nada
+        despues = antes;
+        return false;
+    }
+
+    for (int k = 0; k < plan.size(); ++k) {
+        const Proceso& p = v[plan[k].first];
+        prc.eliminar_job(p.consultar_ID());
+        orden[plan[k].second]->second.add_job(p);
+        ++movs;
+        bytes += p.consultar_MEM();
+    }
+    prc.compactar_mem();
+    actualizar_todos();
+    ++n_rebal;
+    migrado.first += movs;
+    migrado.second += bytes;
+    return true;
+}
+
+void Cluster::modo_hilos(int n) {
+    hilos = n < 1 ? 1 : n;
+    if (hilos == 1) grupo.reset();
+    else if (not grupo or grupo->tamaño() != hilos) grupo = make_shared<Grupo_hilos>(hilos);
+}
+
+void Cluster::modo_tabla(bool b) {
+    con_tabla = b;
+}
+
+void Cluster::modo_especulativo(int k) {
+    espec = k < 0 ? 0 : k;
+}
+
+int Cluster::consultar_especulacion() const {
+    if (comp_parcial or rebal or ambito != -1) return 0;     //recibir_job no sólo busca: se coloca uno a uno
+    return espec;
+}
+
+void Cluster::candidatos(const vector<Proceso>& v, vector<int>& cand) {
+    cambiados.clear();
+    int n = orden.size();
+    int b = v.size();
+    cand.assign(b, -1);
+    Contadores::bfs += (long long)n * b;       //cada bfs_tramo recorre los n, quizá desde otro hilo
+    int k = hilos;
+    if (k > b) k = b;
+    if ((long long)n * b / MIN_TRAMO < k) k = (long long)n * b / MIN_TRAMO;   //poco trabajo: no compensa despertar hilos
+    if (k < 1) k = 1;
+    //el hilo t calcula los procesos t, t + k, t + 2k...; todos leen el mismo estado
+    function<void(int)> parte = [this, &v, &cand, k, n, b](int t) {
+        for (int j = t; j < b; j += k) cand[j] = bfs_tramo(0, n, v[j].consultar_MEM(), v[j].consultar_ID());
+    };
+    if (k == 1) parte(0);
+    else grupo->ejecutar(k, parte);
+    mesp.rondas += (b + k - 1) / k;
+}
+
+bool Cluster::recibir_job_especulado(const Proceso& p, int cand) {
+    int memo = p.consultar_MEM();
+    int id = p.consultar_ID();
+    ++mesp.procesos;
+    int m = cand;
+    if (find(cambiados.begin(), cambiados.end(), cand) != cambiados.end()) {     //el candidato ya no es fiable
+        ++mesp.recalculados;
+        ++mesp.rondas;
+        map<string, Procesador>::iterator it = mprc.end();
+        bfs(it, memo, p.consultar_ID());
+        m = (it == mprc.end()) ? -1 : nodo[it->first];
+    }
+    else {      //los no cambiados siguen como al calcular cand: sólo puede ganar uno cambiado
+        for (int j = 0; j < cambiados.size(); ++j) {
+            int c = cambiados[j];
+            const Procesador& prc = orden[c]->second;
+            int hueco;
+            if (not prc.existe_job(id) and prc.hueco(memo, hueco) and (m == -1 or preferible(m, c, memo))) m = c;
+        }
+        if (m == cand) ++mesp.directos;
+        else ++mesp.corregidos;
+    }
+    if (m == -1) return false;
+    colocar(m, p);
+    if (find(cambiados.begin(), cambiados.end(), m) == cambiados.end()) cambiados.push_back(m);
     return true;
 }
 
-void Cluster::bfs(map<string, Procesador>::iterator& it,const BinTree<string>& tree, int memo, int id) {
-    queue<BinTree<string> > q;
-    q.push(tree);       
+void Cluster::modo_compactacion_parcial(bool b) {
+    comp_parcial = b;
+}
+
+void Cluster::bfs_parcial(map<string, Procesador>::iterator& it, int memo, int id, int& coste) {
+    it = mprc.end();
+    for (int i = 0; i < orden.size(); ++i) {
+        ++Contadores::bfs;
+        Procesador& prc = orden[i]->second;
+        if (not prc.existe_job(id)) {
+            int c = prc.coste_parcial(memo);
+            if (c != -1 and (it == mprc.end() or c < coste)) {     //en caso de empate se queda el primero visitado
+                it = orden[i];
+                coste = c;
+            }
+        }
+    }
+}
+
+void Cluster::ordenar() {
+    orden.clear();
+    prc.clear();
+    padre.clear();
+    hijo.clear();
+    nodo.clear();
+    ambito = -1;
+    if (not Tprc.empty()) {
+        queue<pair<BinTree<string>, pair<int, bool> > > q;     //(subárbol, (posición del padre, es hijo izquierdo))
+        q.push(make_pair(Tprc, make_pair(-1, true)));
+        while (not q.empty()) {
+            BinTree<string> plant (q.front().first);
+            int i = orden.size();
+            int pa = q.front().second.first;
+            nodo[plant.value()] = i;
+            orden.push_back(mprc.find(plant.value()));
+            prc.push_back(&orden.back()->second);
+            padre.push_back(pa);
+            hijo.push_back(make_pair(-1, -1));
+            if (pa != -1) {
+                if (q.front().second.second) hijo[pa].first = i;
+                else hijo[pa].second = i;
+            }
+            if (not plant.left().empty()) q.push(make_pair(plant.left(), make_pair(i, true)));
+            if (not plant.right().empty()) q.push(make_pair(plant.right(), make_pair(i, false)));
+            q.pop();
+        }
+    }
+    agg = vector<Agregado>(orden.size());
+    tabla.redimensionar(orden.size());
+    liberados.clear();          //las posiciones cambian; sólo se reordena entre comandos, cuando ya se han tomado
+    en_liberados.assign(orden.size(), false);
+    actualizar_todos();
+    if (reg) {                  //los procesadores nuevos también se registran
+        for (int i = 0; i < orden.size(); ++i) orden[i]->second.fijar_registro(reg.get());
+    }
+}
+
+bool Cluster::mejor(int a, int b, int memo) const {
+    int ha, hb;
+    orden[a]->second.hueco(memo, ha);
+    orden[b]->second.hueco(memo, hb);
+    return hb < ha or (hb == ha and orden[b]->second.MEM_libre() > orden[a]->second.MEM_libre());
+}
+
+bool Cluster::preferible(int a, int b, int memo) const {
+    int ha, hb;
+    orden[a]->second.hueco(memo, ha);
+    orden[b]->second.hueco(memo, hb);
+    if (ha != hb) return hb < ha;
+    int la = orden[a]->second.MEM_libre();
+    int lb = orden[b]->second.MEM_libre();
+    if (la != lb) return lb > la;
+    return b < a;           //bfs se queda con el primero visitado
+}
+
+int Cluster::bfs_tramo(int ini, int fin, int memo, int id, atomic<int>* cota) const {
+    const Procesador* const* p = prc.data();
+    if (con_tabla and memo > 0) return tabla.buscar(ini, fin, memo, id, p, cota);
+    int m = -1;
     int hollow = -1;
-    while (not q.empty()) {
-        BinTree<string> plant (q.front());          //planta el árbol del frente de la cola
-        map <string, Procesador>::iterator itm = mprc.find(plant.value());  //iterador que apunta al procesador con el id del primer nodo del árbol plantado
+    for (int i = ini; i < fin; ++i) {       //orden ya esta por niveles y de izquierda a derecha
         int hueco;
-        if (not itm->second.existe_job(id) and itm->second.hueco(memo, hueco)) {    //el id del proceso no existe en el procesador y cabe 
-            if (it == mprc.end() or hueco < hollow) {   //el hueco del procesador actual esta más ajustado que el del procesador con hueco más ajustado (anteriormente) 
-                it = itm;
+        if (tabla.mayor_hueco(i) >= memo and not p[i]->existe_job(id) and p[i]->hueco(memo, hueco)) {    //el id del proceso no existe en el procesador y cabe 
+            if (cota != nullptr and hueco > cota->load(memory_order_relaxed)) continue;     //otro tramo ya tiene uno mejor
+            if (m == -1 or hueco < hollow) {   //el hueco del procesador actual esta más ajustado que el del procesador con hueco más ajustado (anteriormente) 
+                m = i;
                 hollow = hueco;
+                if (cota != nullptr) Tabla_huecos::publicar(cota, hollow);
             }
-            else if (hueco == hollow and itm->second.MEM_libre() > it->second.MEM_libre()) it = itm;   //escoje el procesador con más memoria libre 
+            else if (hueco == hollow and p[i]->MEM_libre() > p[m]->MEM_libre()) m = i;   //escoje el procesador con más memoria libre 
         }
-        if (not plant.left().empty()) q.push(plant.left()); //si el subárbol izquierdo no esta vacio añadelo a la cola (preorden)
-        if (not plant.right().empty()) q.push(plant.right());   //después el derecho
-        q.pop();    //el primer nodo del árbol ya ha sido visitado por lo tanto se borra de la cola
-    } 
+    }
+    return m;
+}
+
+void Cluster::recalcular(int i) {
+    const Procesador& prc = orden[i]->second;
+    Agregado& a = agg[i];
+    a.max_hueco = prc.max_hueco();
+    a.procesos = prc.num_procesos();
+    a.capacidad = prc.MEM_max();
+    a.libre = prc.MEM_max() - prc.MEM_ocupada();
+    int h[2] = {hijo[i].first, hijo[i].second};
+    for (int k = 0; k < 2; ++k) {
+        if (h[k] != -1) {
+            const Agregado& b = agg[h[k]];
+            if (b.max_hueco > a.max_hueco) a.max_hueco = b.max_hueco;
+            a.procesos += b.procesos;
+            a.capacidad += b.capacidad;
+            a.libre += b.libre;
+        }
+    }
+}
+
+void Cluster::actualizar(int i) {
+    tabla.fijar(i, orden[i]->second);
+    while (i != -1) {
+        recalcular(i);
+        i = padre[i];
+    }
+}
+
+void Cluster::actualizar_todos() {
+    for (int i = int(orden.size()) - 1; i >= 0; --i) {      //los hijos van despues que el padre en orden
+        tabla.fijar(i, orden[i]->second);
+        recalcular(i);
+    }
+}
+
+bool Cluster::fijar_ambito(const string& id) {
+    unordered_map<string, int>::const_iterator it = nodo.find(id);
+    if (it == nodo.end()) {
+        cout << "error: no existe procesador" << endl;
+        return false;
+    }
+    ambito = it->second;
+    return true;
+}
+
+void Cluster::quitar_ambito() {
+    ambito = -1;
+}
+
+bool Cluster::recibir_job_ambito(const Proceso& p) {
+    int memo = p.consultar_MEM();
+    int id = p.consultar_ID();
+    int m = -1;
+    int hollow = -1;
+    vector<int> pila(1, ambito);
+    while (not pila.empty()) {
+        int i = pila.back();
+        pila.pop_back();
+        ++Contadores::bfs;
+        if (agg[i].max_hueco >= memo) {         //si no, en todo el subárbol no cabe
+            const Procesador& prc = orden[i]->second;
+            int hueco;
+            if (not prc.existe_job(id) and prc.hueco(memo, hueco)) {
+                //mismo criterio que bfs: hueco más ajustado, más memoria libre, menor posición en orden
+                if (m == -1 or hueco < hollow or (hueco == hollow and (prc.MEM_libre() > orden[m]->second.MEM_libre()
+                    or (prc.MEM_libre() == orden[m]->second.MEM_libre() and i < m)))) {
+                    m = i;
+                    hollow = hueco;
+                }
+            }
+            if (hijo[i].second != -1) pila.push_back(hijo[i].second);
+            if (hijo[i].first != -1) pila.push_back(hijo[i].first);
+        }
+    }
+    if (m == -1) return false;
+    colocar(m, p);
+    return true;
+}
+
+void Cluster::escribir_uso(const string& id) const {
+    unordered_map<string, int>::const_iterator it = nodo.find(id);
+    if (it == nodo.end()) cout << "error: no existe procesador" << endl;
+    else {
+        const Agregado& a = agg[it->second];
+        cout << a.procesos << ' ' << a.capacidad - a.libre << ' ' << a.capacidad << ' ' << a.max_hueco << endl;
+    }
+}
+
+void Cluster::escribir_uso() const {
+    if (agg.empty()) cout << "0 0 0 0" << endl;
+    else cout << agg[0].procesos << ' ' << agg[0].capacidad - agg[0].libre << ' ' << agg[0].capacidad << ' ' << agg[0].max_hueco << endl;
+}
+
+void Cluster::bfs(map<string, Procesador>::iterator& it, int memo, int id) {
+    Perfil::Tramo tr("Cluster::bfs");
+    int n = orden.size();
+    Contadores::bfs += n;       //bfs_tramo recorre los n, quizá desde otros hilos: se cuentan aquí
+    int k = hilos;
+    if (n / MIN_TRAMO < k) k = n / MIN_TRAMO;
+    int m;
+    if (k <= 1) m = bfs_tramo(0, n, memo, id);
+    else {      //cada tramo devuelve su candidato y se combinan en orden, con el mismo criterio
+        vector<int> res(k);
+        atomic<int> cota(INT_MAX);      //mejor hueco encontrado por cualquier tramo
+        grupo->ejecutar(k, [this, &res, &cota, k, n, memo, id](int t) {
+            res[t] = bfs_tramo((long long)n * t / k, (long long)n * (t + 1) / k, memo, id, &cota);
+        });
+        m = -1;
+        for (int t = 0; t < k; ++t) {
+            if (res[t] != -1 and (m == -1 or mejor(m, res[t], memo))) m = res[t];
+        }
+    }
+    if (m != -1) it = orden[m];
 }
 
 void Cluster::add_job_prc(const string& idprc, Proceso& p) {
@@ -43,7 +575,21 @@ void Cluster::add_job_prc(const string& idprc, Proceso& p) {
     if (it == mprc.end()) cout << "error: no existe procesador" << endl;
     else {
         if (it->second.existe_job(p.consultar_ID())) cout << "error: ya existe proceso" << endl;
-        else it->second.add_job(p);
+        else {
+            it->second.add_job(p);
+            actualizar(nodo[idprc]);
+        }
+    }
+}
+
+void Cluster::add_jobs_prc(const string& idprc, const vector<Proceso>& v) {
+    map<string, Procesador>::iterator it = mprc.find(idprc);
+    if (it == mprc.end()) {
+        for (int i = 0; i < v.size(); ++i) cout << "error: no existe procesador" << endl;
+    }
+    else {
+        it->second.add_jobs(v);
+        actualizar(nodo[idprc]);
     }
 }
 
@@ -51,16 +597,37 @@ void Cluster::eliminar_job_prc(const string& idprc, int idjob) {
    map<string, Procesador>::iterator it = mprc.find(idprc);
    if (it == mprc.end()) cout << "error: no existe procesador" << endl;
    else {
-        map <int,Proceso>::iterator it1;
-        it->second.eliminar_job(idjob, it1);
+        int antes = it->second.num_procesos();
+        it->second.eliminar_job(idjob);
+        anotar_liberado(nodo[idprc], antes);
+        actualizar(nodo[idprc]);
    }
 }
 
+void Cluster::eliminar_jobs_prc(const string& idprc, const vector<int>& idjobs) {
+    map<string, Procesador>::iterator it = mprc.find(idprc);
+    if (it == mprc.end()) {
+        for (int i = 0; i < idjobs.size(); ++i) cout << "error: no existe procesador" << endl;
+    }
+    else {
+        int antes = it->second.num_procesos();
+        it->second.eliminar_jobs(idjobs);
+        anotar_liberado(nodo[idprc], antes);
+        actualizar(nodo[idprc]);
+    }
+}
+
 void Cluster::avanzar_tiempo_prc(int t) {
+    Perfil::Tramo tr("Cluster::avanzar_tiempo_prc");
     map <string, Procesador>::iterator it;
     for (it = mprc.begin(); it != mprc.end(); ++it) {
-        it->second.avanzar_tiempo(t);
+        int antes = it->second.num_procesos();
+        it->second.avanzar_tiempo(t);       //las finalizaciones se registran respecto al reloj anterior
+        if (it->second.num_procesos() < antes) anotar_liberado(nodo[it->first], antes);
     }
+    reloj += t;
+    if (reg) reg->fijar_tiempo(reloj);
+    actualizar_todos();
 }
 
 void Cluster::compactar() { 
@@ -69,12 +636,44 @@ void Cluster::compactar() {
         it->second.compactar_mem();
         ++it;
     }
+    actualizar_todos();
 }
 
 void Cluster::compactar_prc(const string& id) {
     map<string,Procesador>::iterator it = mprc.find(id);
     if (it == mprc.end()) cout << "error: no existe procesador" << endl;
-    else it->second.compactar_mem();
+    else {
+        it->second.compactar_mem();
+        actualizar(nodo[id]);
+    }
+}
+
+int Cluster::consultar_tiempo() const {
+    return reloj;
+}
+
+void Cluster::escribir_metricas_compactacion() const {
+    cout << n_parcial << ' ' << movido.first << ' ' << movido.second << ' '
+         << desplazados.first << ' ' << desplazados.second << endl;
+}
+
+void Cluster::escribir_metricas_rebalanceo() const {
+    long long sin = 0, con = 0;     //porcentajes de aceptación sin y con los rebalanceos
+    if (acept.recibidos > 0) {
+        sin = 100 * (acept.aceptados - acept.rescatados) / acept.recibidos;
+        con = 100 * acept.aceptados / acept.recibidos;
+    }
+    cout << n_rebal << ' ' << migrado.first << ' ' << migrado.second << ' ' << acept.recibidos << ' '
+         << acept.aceptados - acept.rescatados << ' ' << acept.aceptados << ' ' << sin << "% " << con << '%' << endl;
+}
+
+void Cluster::escribir_metricas_especulacion() const {
+    long long conflictos = 0;
+    long long acel = 100;           //en centésimas
+    if (mesp.procesos > 0) conflictos = 100 * (mesp.corregidos + mesp.recalculados) / mesp.procesos;
+    if (mesp.rondas > 0) acel = 100 * mesp.procesos / mesp.rondas;
+    cout << mesp.procesos << ' ' << mesp.directos << ' ' << mesp.corregidos << ' ' << mesp.recalculados
+         << ' ' << conflictos << "% " << acel / 100 << '.' << (acel % 100 < 10 ? "0" : "") << acel % 100 << endl;
 }
 
 map<string, Procesador> Cluster::blend() const {
@@ -90,6 +689,7 @@ void Cluster::añadir_cluster(Cluster& c, const string& id) {
             mprc.erase(it);
             map<string,Procesador> mix = c.blend();        //mix tiene el map del cluster auxiliar
             mprc.insert(mix.begin(), mix.end());           //unimos (blend) el map principal con el auxiliar
+            ordenar();
         }
     }
 }
@@ -140,24 +740,60 @@ void Cluster::leer_arbol(BinTree<string>& a, map <string, Procesador>& mpr) {
 void Cluster::leer() {
  mprc.clear();
  leer_arbol(Tprc, mprc);
+ ordenar();
 }
 
-void Cluster::escribir_arbol(const BinTree<string>& a) {
+void Cluster::escribir_arbol(const BinTree<string>& a, ostream& os) {
     if (not a.empty()) {
-        cout << '(';
-        cout << a.value();
-        escribir_arbol(a.left());
-        escribir_arbol(a.right());
-        cout << ')';
+        os << '(';
+        os << a.value();
+        escribir_arbol(a.left(), os);
+        escribir_arbol(a.right(), os);
+        os << ')';
     }
-    else cout << ' ';
+    else os << ' ';
 }
 
 void Cluster::escribir_est() const {
-    escribir_arbol(Tprc);
+    escribir_arbol(Tprc, cout);
     cout << endl;
 }
 
+BinTree<string> Cluster::estructura() const {
+    return Tprc;
+}
+
+void Cluster::escribir_est(ostream& os, const BinTree<string>& a) {
+    escribir_arbol(a, os);
+    os << '\n';
+}
+
+void Cluster::instantanea_todos(Instantanea& s) const {
+    s.resize(mprc.size());
+    int i = 0;
+    for (map <string,Procesador>::const_iterator it = mprc.begin(); it != mprc.end(); ++it, ++i) {
+        s[i].first = it->first;
+        if (it->second.en_curso()) it->second.instantanea(s[i].second);
+    }
+}
+
+void Cluster::escribir_todos(ostream& os, const Instantanea& s) {
+    for (int i = 0; i < s.size(); ++i) {
+        os << s[i].first << '\n';
+        Procesador::escribir(os, s[i].second);
+    }
+}
+
+bool Cluster::instantanea_prc(const string& id, Procesador::Instantanea& s) const {
+    map<string, Procesador>::const_iterator it = mprc.find(id);
+    if (it == mprc.end()) {
+        cout << "error: no existe procesador" << endl;
+        return false;
+    }
+    if (it->second.en_curso()) it->second.instantanea(s);
+    return true;
+}
+
 void Cluster::escribir_todos() const {
     for (map <string,Procesador>::const_iterator it = mprc.begin(); it != mprc.end(); ++it) {
         cout << it->first << endl;
@@ -165,6 +801,15 @@ void Cluster::escribir_todos() const {
     }
 }
 
+void Cluster::escribir_cambios() {
+    for (map <string,Procesador>::iterator it = mprc.begin(); it != mprc.end(); ++it) {
+        if (it->second.con_cambios()) {
+            cout << it->first << endl;
+            it->second.escribir_cambios();
+        }
+    }
+}
+
  void Cluster::escribir_prc(const string& id, map<string,Procesador>::const_iterator& it) const { 
     if (id != "*") {        
         it = mprc.find(id);
@@ -172,4 +817,41 @@ void Cluster::escribir_todos() const {
         else if (it->second.en_curso()) it->second.escribir();  //si el procesador tiene procesos ejecutandose escribe sus atributos
     }
     else if (it->second.en_curso()) it->second.escribir(); 
- }
\ No newline at end of file
+ }
+
+int Cluster::comprobar_invariantes() const {
+    int fallos = 0;
+    if (orden.size() != mprc.size() or agg.size() != orden.size()) {
+        cout << "error: invariante cluster orden" << endl;
+        return 1;
+    }
+    for (int i = 0; i < orden.size(); ++i) {
+        const Procesador& prc = orden[i]->second;
+        fallos += prc.comprobar();
+        Agregado a;             //mismo cálculo que recalcular(), a partir de los hijos guardados
+        a.max_hueco = prc.max_hueco();
+        a.procesos = prc.num_procesos();
+        a.capacidad = prc.MEM_max();
+        a.libre = prc.MEM_max() - prc.MEM_ocupada();
+        int h[2] = {hijo[i].first, hijo[i].second};
+        for (int k = 0; k < 2; ++k) {
+            if (h[k] != -1) {
+                const Agregado& b = agg[h[k]];
+                if (b.max_hueco > a.max_hueco) a.max_hueco = b.max_hueco;
+                a.procesos += b.procesos;
+                a.capacidad += b.capacidad;
+                a.libre += b.libre;
+            }
+        }
+        const Agregado& g = agg[i];
+        if (a.max_hueco != g.max_hueco or a.procesos != g.procesos or a.capacidad != g.capacidad or a.libre != g.libre) {
+            cout << "error: invariante " << orden[i]->first << " resumen" << endl;
+            ++fallos;
+        }
+        if (not tabla.al_dia(i, prc)) {
+            cout << "error: invariante " << orden[i]->first << " tabla" << endl;
+            ++fallos;
+        }
+    }
+    return fallos;
+}
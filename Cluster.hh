@@ -7,6 +7,8 @@
 
 #include "Procesador.hh"
 #include "Proceso.hh"
+#include "Tabla_huecos.hh"
+#include "Grupo_hilos.hh"
 #ifndef NO_DIAGRAM
 #include <iostream>
 #include <queue>
@@ -15,6 +17,11 @@
 #include <list>
 #include <utility>
 #include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <memory>
 #endif
 
 /** @class Cluster
@@ -27,12 +34,150 @@
 
 class Cluster {
 
+public:
+    /** @brief Copia de sólo lectura de los procesadores: id y copia de cada uno (vacía si no tiene procesos) */
+    typedef vector<pair<string, Procesador::Instantanea> > Instantanea;
+
 private:
     /** @brief Estructura en árbol de los procesadores del cluster */
     BinTree<string> Tprc;
     
     /** @brief Map de procesadores ordenado crecientemente por su id */
     map <string, Procesador> mprc;
+
+    /** @brief Procesadores del cluster en orden breadth-first (por niveles y de izquierda a derecha)
+
+      Son iteradores de mprc: por eso, igual que nodo, agg y tabla, que se indexan
+      por posición en orden, el p.i. no se puede copiar */
+    vector<map<string, Procesador>::iterator> orden;
+
+    /** @brief Puntero al procesador de cada posición de orden
+
+      Los tramos de bfs leen los procesadores por aquí y los huecos de tabla: con
+      -D_GLIBCXX_DEBUG cada iterador que se crea toma un mutex global de la
+      biblioteca, y los hilos de la búsqueda se serializarían en él */
+    vector<const Procesador*> prc;
+
+    /** @brief Posición en orden del padre de cada procesador (-1 para la raíz) */
+    vector<int> padre;
+
+    /** @brief Posiciones en orden de los hijos izquierdo (first) y derecho (second) de cada procesador (-1 si no hay) */
+    vector<pair<int, int> > hijo;
+
+    /** @brief Posición en orden de cada procesador según su id */
+    unordered_map<string, int> nodo;
+
+    /** @brief Resumen de un subárbol de procesadores */
+    struct Agregado {
+        int max_hueco;          //mayor hueco de los procesadores del subárbol
+        int procesos;           //procesos en ejecución en el subárbol
+        long long capacidad;    //memoria total del subárbol
+        long long libre;        //memoria no ocupada por procesos en el subárbol
+    };
+
+    /** @brief Resumen del subárbol de cada procesador, en el orden de orden */
+    vector<Agregado> agg;
+
+    /** @brief Huecos de cada procesador en columnas, en el orden de orden */
+    Tabla_huecos tabla;
+
+    /** @brief Indica si bfs recorre tabla (si no, recorre los procesadores de orden) */
+    bool con_tabla;
+
+    /** @brief Posición en orden de la raíz del subárbol al que se limita recibir_job (-1 = sin límite)
+
+      La raíz del cluster es la posición 0: limitar a ella no busca en otros procesadores
+      que sin límite, pero como cualquier ámbito coloca sin compactación parcial ni
+      rebalanceo */
+    int ambito;
+
+    /** @brief Número máximo de hilos con los que bfs reparte la búsqueda */
+    int hilos;
+
+    /** @brief Hilos de trabajo de bfs y candidatos, creados una vez por modo_hilos (nulo con un hilo) */
+    shared_ptr<Grupo_hilos> grupo;
+
+    /** @brief Mínimo de procesadores por hilo para que bfs reparta la búsqueda */
+    static const int MIN_TRAMO = 1 << 14;
+
+    /** @brief Reloj simulado: suma de todos los avances de tiempo del cluster */
+    int reloj;
+
+    /** @brief Registro de eventos de los procesadores, nulo si no se registran */
+    shared_ptr<Registro> reg;
+
+    /** @brief Indica si recibir_job puede compactar parcialmente un procesador cuando el proceso no cabe */
+    bool comp_parcial;
+
+    /** @brief Compactaciones parciales hechas por recibir_job */
+    int n_parcial;
+
+    /** @brief Memoria desplazada por las compactaciones parciales (first) y la que
+        habrían desplazado compactaciones completas de los mismos procesadores (second) */
+    pair<long long, long long> movido;
+
+    /** @brief Procesos desplazados por las compactaciones parciales (first) y los que
+        habrían desplazado compactaciones completas de los mismos procesadores (second) */
+    pair<long long, long long> desplazados;
+
+    /** @brief Indica si recibir_job puede migrar procesos entre procesadores cuando el proceso no cabe */
+    bool rebal;
+
+    /** @brief Rebalanceos hechos (por comando o por recibir_job) */
+    int n_rebal;
+
+    /** @brief Procesos migrados (first) y memoria migrada (second) por todos los rebalanceos */
+    pair<int, long long> migrado;
+
+    /** @brief Aceptación de recibir_job fuera de un ámbito */
+    struct Aceptacion {
+        long long recibidos;        //procesos que ha intentado colocar
+        long long aceptados;        //procesos colocados
+        long long rescatados;       //colocados sólo gracias a un rebalanceo
+    };
+
+    /** @brief Aceptación acumulada de recibir_job */
+    Aceptacion acept;
+
+    /** @brief Número de procesos cuyo candidato se calcula por adelantado en epc (0 = sin especulación) */
+    int espec;
+
+    /** @brief Posiciones en orden de los procesadores que han recibido procesos desde el último cálculo de candidatos */
+    vector<int> cambiados;
+
+    /** @brief Métricas de la especulación */
+    struct Metricas_espec {
+        long long procesos;         //procesos colocados o rechazados con candidato especulado
+        long long directos;         //el candidato seguía siendo el mejor
+        long long corregidos;       //un procesador cambiado era mejor: se escoge sin búsqueda
+        long long recalculados;     //el candidato había cambiado: búsqueda completa
+        long long rondas;           //búsquedas completas en paralelo (una por hilo y lote)
+    };
+
+    /** @brief Métricas acumuladas de la especulación */
+    Metricas_espec mesp;
+
+    /** @brief Indica si se está avanzando el tiempo por eventos (entre abrir_eventos() y cerrar_eventos()) */
+    bool eventos;
+
+    /** @brief Instante al que están referidos los tiempos restantes de cada procesador, en el orden de orden
+
+      Sólo mientras se avanza por eventos: los procesadores sin finalizaciones no se
+      recorren y sus tiempos restantes se actualizan al cerrar */
+    vector<int> base;
+
+    /** @brief Próxima finalización (instante absoluto, cota inferior) de cada procesador, en el orden de orden, -1 si no tiene procesos */
+    vector<long long> plazo;
+
+    /** @brief Pares (plazo, posición en orden) de los procesadores con procesos: el primero es el próximo evento */
+    set<pair<long long, int> > plazos;
+
+    /** @brief Posiciones en orden, sin repetir, de los procesadores donde ha acabado o se ha
+        eliminado algún proceso desde la última llamada a tomar_liberado() */
+    vector<int> liberados;
+
+    /** @brief Indica para cada posición en orden si está en liberados */
+    vector<bool> en_liberados;
   
    /** @brief Operación de lectura de un árbol de procesadores
       \pre  a es vacío; 
@@ -43,22 +188,148 @@ private:
     
     /** @brief Operación de escritura de un árbol de procesadores
       \pre  <em>cierto</em>
-      \post Se ha escrito a por el canal de salida estándard
+      \post Se ha escrito a por el canal os
       \coste Lineal respecto al número de procesadores del árbol escrito
   */
-    static void escribir_arbol(const BinTree<string>& a);
+    static void escribir_arbol(const BinTree<string>& a, ostream& os);
+
+    /** @brief Recalcula el orden breadth-first de los procesadores
+      \pre Tprc y mprc contienen los mismos procesadores
+      \post orden contiene un iterador de mprc por cada nodo de Tprc, por niveles
+      y de izquierda a derecha
+      \coste Lineal respecto al número de procesadores por logarítmico (búsqueda en el map)
+  */
+    void ordenar();
+
+    /** @brief Recalcula el resumen de un subárbol
+      \pre Los resúmenes de los hijos de i están actualizados
+      \post agg[i] resume el procesador i y los resúmenes de sus hijos
+      \coste Constante
+  */
+    void recalcular(int i);
+
+    /** @brief Actualiza los resúmenes tras cambiar un procesador
+      \pre Sólo ha cambiado el procesador i desde la última actualización
+      \post Los resúmenes de i y de todos sus antecesores y la fila i de tabla están actualizados
+      \coste Lineal respecto a la profundidad de i, más logarítmico sobre los huecos de i por clase de tamaño
+  */
+    void actualizar(int i);
+
+    /** @brief Actualiza los resúmenes de todos los subárboles
+      \pre <em>cierto</em>
+      \post agg y tabla están actualizados
+      \coste Lineal respecto al número de procesadores (por clase de tamaño en tabla)
+  */
+    void actualizar_todos();
+
+    /** @brief Coloca un proceso en un procesador
+      \pre El proceso p cabe en el procesador m de orden y no existe en él
+      \post Se ha añadido p al procesador m y se han actualizado los resúmenes; si se
+      avanza por eventos, el tiempo de p se ha referido al instante base[m] y se ha
+      actualizado el plazo de m
+      \coste Logarítmico más lineal respecto a la profundidad de m
+  */
+    void colocar(int m, const Proceso& p);
+
+    /** @brief Actualiza el plazo de un procesador
+      \pre Se avanza por eventos
+      \post plazo[m] y plazos reflejan la próxima finalización de m (al menos una
+      unidad después de base[m])
+      \coste Logarítmico
+  */
+    void planificar(int m);
+
+    /** @brief Anota un procesador en el que pueden haber acabado o haberse eliminado procesos
+      \pre 0 <= m < orden.size(), antes es el número de procesos del procesador m antes de
+      finalizar o eliminar procesos
+      \post Si el procesador m tiene menos procesos que antes, está en liberados (aunque
+      su mayor hueco no haya crecido, ahora caben los procesos con el id de los que ha perdido)
+      \coste Constante amortizado
+  */
+    void anotar_liberado(int m, int antes);
+
+    /** @brief Pone al día los tiempos de un procesador
+      \pre Se avanza por eventos, base[m] <= reloj
+      \post Se ha avanzado el tiempo del procesador m en reloj - base[m] (registrando
+      las finalizaciones en su instante), base[m] = reloj y su plazo está actualizado
+      \coste Lineal respecto al número de procesos de m
+  */
+    void adelantar(int m);
+
+    /** @brief Pone al día los tiempos de todos los procesadores
+      \pre Se avanza por eventos
+      \post Todos los procesadores cumplen base[i] = reloj
+      \coste Lineal respecto al número de procesos de los procesadores atrasados
+  */
+    void sincronizar();
+
+    /** @brief Añade un proceso en el mejor procesador del subárbol ambito
+      \pre ambito != -1
+      \post Como recibir_job pero sólo entre los procesadores del subárbol con
+      raíz en ambito (sin compactación parcial ni rebalanceo); se descartan los
+      subárboles cuyo mayor hueco no cabe el proceso
+      \coste Lineal respecto al número de procesadores visitados del subárbol
+  */
+    bool recibir_job_ambito(const Proceso& p);
 
     /** @brief Operación de busqueda breadth-first search del procesador "ideal" para
      * el proceso
-      \pre <em>cierto</em>
+      \pre orden está actualizado
       \post Actualiza el iterador del mapa de procesadores, apunta al procesador
       con memoria más ajustada, en caso de empate el que tenga más memoria libre,
       en caso de empate el más cercano a la raíz, si todavia continua el empate
        el de más a la izquierda, sino apunta al .end()
 
-      \coste Lineal respecto al número de procesadores del árbol
+      \coste Lineal respecto al número de procesadores del árbol (recorrido de tabla;
+      sólo se consultan los huecos de los procesadores que la tabla no descarta),
+      repartido entre como mucho hilos tramos contiguos de orden que se recorren
+      en paralelo
+  */
+    void bfs (map<string, Procesador>::iterator& it, int memo, int id);
+
+    /** @brief Búsqueda del procesador "ideal" en un tramo de orden
+      \pre 0 <= ini <= fin <= orden.size()
+      \post El resultado es la posición en orden del procesador de [ini, fin) que
+      escogería bfs si sólo existieran esos procesadores, -1 si no hay ninguno; con
+      con_tabla y memo > 0 recorre tabla y si no, los procesadores de prc (sólo
+      consulta el hueco de los que tabla no descarta por su mayor hueco). Si cota
+      no es nula la comparten los tramos que buscan a la vez: descarta además los
+      procesadores con un hueco mayor que ella y publica en ella los mejores huecos
+      que encuentra (consultar buscar() de la clase Tabla_huecos)
+      \coste Lineal respecto a fin - ini
+  */
+    int bfs_tramo(int ini, int fin, int memo, int id, atomic<int>* cota = nullptr) const;
+
+    /** @brief Compara dos candidatos de bfs
+      \pre a y b son posiciones de procesadores de orden en los que cabe memo, a < b
+      \post El resultado indica si bfs prefiere b a a (hueco más ajustado, o igual y más memoria libre)
+      \coste Logarítmico (consulta de huecos)
   */
-    void bfs (map<string, Procesador>::iterator& it,const BinTree<string>& tree, int memo, int id);
+    bool mejor(int a, int b, int memo) const;
+
+    /** @brief Compara dos procesadores con el criterio completo de bfs
+      \pre a y b son posiciones de procesadores de orden en los que cabe memo
+      \post El resultado indica si bfs prefiere b a a (hueco más ajustado, o igual y
+      más memoria libre, o igual y antes en orden)
+      \coste Logarítmico (consulta de huecos)
+  */
+    bool preferible(int a, int b, int memo) const;
+
+    /** @brief Búsqueda breadth-first search del procesador más barato de compactar parcialmente
+      \pre memo > 0, orden está actualizado
+      \post Actualiza it al procesador sin el proceso id en el que compactar_parcial(memo)
+      desplaza menos memoria (el más cercano a la raíz y más a la izquierda en caso
+      de empate) y coste a esa memoria; si no hay ninguno it apunta al .end()
+      \coste Lineal respecto al número de procesos del cluster
+  */
+    void bfs_parcial(map<string, Procesador>::iterator& it, int memo, int id, int& coste);
+
+    /** @brief Orden de migración: primero los procesos de más memoria
+      \pre <em>cierto</em>
+      \post El resultado indica si a ocupa más memoria que b
+      \coste Constante
+  */
+    static bool mas_memoria(const Proceso& a, const Proceso& b);
 
     /** @brief Modificadora del arbol del cluster añadiendo un subarbol a este 
       \pre El procesador con ID = id existe y no contiene procesos en ejecución
@@ -84,7 +355,8 @@ private:
   */
     map<string, Procesador> blend() const;
 
-
+    Cluster(const Cluster&) = delete;
+    Cluster& operator=(const Cluster&) = delete;
 
 public:
 
@@ -94,7 +366,7 @@ public:
 
       Se ejecuta automáticamente al declarar un clúster.
       \pre <em>cierto</em>
-      \post El resultado es un clúster no inicializado
+      \post El resultado es un clúster no inicializado con el reloj a 0
       \coste Constante 
   */
     Cluster();
@@ -105,11 +377,151 @@ public:
      
       \pre <em>cierto</em>
       \post Retorna true si el proceso p cabe en almenos un procesador del cluster
-      y ademas lo añade a ese procesador, retorna false en caso contrario
-      \coste Lineal (coste de bfs) sobre logarítmico (coste de add_job de proceso)
+      y ademas lo añade a ese procesador, retorna false en caso contrario. Con la
+      compactación parcial activada, si no cabe en ningún hueco se compacta
+      parcialmente el procesador más barato (consultar bfs_parcial()) y se añade allí;
+      con el rebalanceo activado, si aún no cabe se rebalancea el cluster y se reintenta
+      \coste Lineal (coste de bfs) sobre logarítmico (coste de add_job de proceso),
+      más lineal sobre el número de procesos si se recurre a la compactación parcial
+      o al rebalanceo (consultar rebalancear())
     */
     bool recibir_job(const Proceso& p);
 
+    /** @brief Activa o desactiva la compactación parcial en recibir_job
+
+      \pre <em>cierto</em>
+      \post recibir_job compacta parcialmente cuando un proceso no cabe si y solo si b
+      \coste Constante
+    */
+    void modo_compactacion_parcial(bool b);
+
+    /** @brief Fija el número de hilos de la búsqueda de procesador
+
+      \pre n >= 1
+      \post bfs reparte la búsqueda entre como mucho n hilos cuando cada uno
+      recibe al menos MIN_TRAMO procesadores; el resultado no cambia. Los n - 1
+      hilos de trabajo se crean aquí y duran hasta el siguiente cambio: cada
+      búsqueda sólo los despierta. Compilado con _GLIBCXX_DEBUG (las OPCIONS por
+      defecto del Makefile) cada iterador con comprobaciones se da de alta y de baja
+      bajo un mutex global de la biblioteca, así que los tramos apenas avanzan en
+      paralelo: la aceleración sólo aparece compilando sin esa opción
+      \coste Lineal respecto a n (creación de los hilos)
+    */
+    void modo_hilos(int n);
+
+    /** @brief Escoge cómo recorre bfs los procesadores
+
+      \pre <em>cierto</em>
+      \post bfs recorre la tabla de huecos si b y si no, los procesadores uno a uno;
+      el resultado no cambia
+      \coste Constante
+    */
+    void modo_tabla(bool b);
+
+    /** @brief Limita recibir_job al subárbol de un procesador
+
+      \pre <em>cierto</em>
+      \post Si existe el procesador con ID = id, recibir_job sólo coloca procesos en
+      su subárbol y devuelve true; si no, se ha escrito un mensaje de error y devuelve false
+      \coste Constante en promedio
+    */
+    bool fijar_ambito(const string& id);
+
+    /** @brief Deja de limitar recibir_job a un subárbol
+
+      \pre <em>cierto</em>
+      \post recibir_job vuelve a buscar en todo el cluster
+      \coste Constante
+    */
+    void quitar_ambito();
+
+    /** @brief Fija el tamaño de los lotes de la colocación especulativa
+
+      \pre k >= 0
+      \post Si k > 0, enviar_proceso de Prioridad calcula en paralelo (consultar
+      candidatos()) el procesador de lotes de hasta k procesos antes de colocarlos;
+      si k = 0 coloca los procesos uno a uno. El resultado no cambia
+      \coste Constante
+    */
+    void modo_especulativo(int k);
+
+    /** @brief Consulta si se puede usar la colocación especulativa
+
+      \pre <em>cierto</em>
+      \post El resultado es el tamaño de lote de la especulación si está activada y
+      recibir_job no compacta, no rebalancea ni está limitado a un subárbol; 0 si no
+      \coste Constante
+    */
+    int consultar_especulacion() const;
+
+    /** @brief Calcula por adelantado el procesador de un lote de procesos
+
+      \pre consultar_especulacion() > 0
+      \post cand[j] es la posición en orden del procesador que escogería bfs para v[j]
+      en el estado actual del p.i. (-1 si no cabe en ninguno); los procesos de v se
+      reparten entre como mucho hilos hilos. Se olvidan los procesadores cambiados
+      \coste Lineal respecto al tamaño de v por el número de procesadores, dividido
+      entre los hilos
+    */
+    void candidatos(const vector<Proceso>& v, vector<int>& cand);
+
+    /** @brief Añade un proceso usando su candidato calculado por adelantado
+
+      \pre cand se ha calculado con candidatos() para p y desde entonces sólo se han
+      colocado procesos con esta operación
+      \post Igual que recibir_job(p). Si el procesador cand no ha recibido procesos
+      desde el cálculo, el mejor procesador es el mejor entre cand y los que han
+      cambiado, sin búsqueda; si no, se busca en todo el cluster
+      \coste Lineal respecto al número de procesadores cambiados por logarítmico,
+      o el de recibir_job si cand ha cambiado
+    */
+    bool recibir_job_especulado(const Proceso& p, int cand);
+
+    /** @brief Migra procesos entre procesadores para abrir un hueco
+
+      \pre orden está actualizado, memo >= 0
+      \post Con memo > 0 el hueco a abrir es de memo para un proceso pendiente de id id;
+      con memo = 0, mayor que el mayor hueco actual del cluster. Son objetivos posibles
+      los procesadores sin ese hueco que lo tendrían sin sus procesos y cuyos procesos
+      caben en la memoria libre de los demás; si no hay ninguno el p.i. no cambia y
+      devuelve false sin recorrer los huecos. Con memo > 0 se escoge el objetivo que
+      ha de migrar menos memoria (en caso de empate, el de más memoria); con memo = 0,
+      el de más memoria (en caso de empate, el que tiene menos memoria ocupada); si
+      el empate sigue, el más cercano a la raíz y más a la izquierda.
+      Se planifica mover procesos del objetivo (antes el de id, si lo tiene; después
+      de mayor a menor memoria) al hueco más ajustado de otro procesador que no
+      contenga su id (el primero en orden breadth-first en caso de empate), con
+      memo > 0 sólo hasta que el proceso pendiente quepa en el objetivo. Si el plan
+      abre el hueco se ejecuta (los procesos conservan su tiempo restante), se
+      compacta el objetivo y devuelve true; en caso contrario el p.i. no cambia y
+      devuelve false. movs y bytes son los procesos y la memoria migrados, antes y
+      despues el mayor hueco del cluster antes y después
+      \coste Lineal sobre el número de procesadores; si hay objetivo, lineal sobre el
+      número de procesos y huecos del cluster por logarítmico
+    */
+    bool rebalancear(int memo, int id, int& movs, long long& bytes, int& antes, int& despues);
+
+    /** @brief Activa o desactiva el rebalanceo automático en recibir_job
+
+      \pre <em>cierto</em>
+      \post Si b, cuando un proceso no cabe en ningún procesador recibir_job
+      rebalancea el cluster y vuelve a intentarlo
+      \coste Constante
+    */
+    void modo_rebalanceo(bool b);
+
+    /** @brief Activa o desactiva el registro de eventos
+
+      \pre <em>cierto</em>
+      \post Se ha cerrado el registro anterior, si lo había, tras escribir todos sus
+      eventos. Si fich es "-" no se registran eventos; si no, las colocaciones,
+      finalizaciones, eliminaciones y desplazamientos de procesos de todos los
+      procesadores se registran en el fichero fich (consultar la clase Registro), y
+      si no se puede abrir se ha escrito un mensaje de error y no se registran
+      \coste Lineal respecto al número de procesadores
+    */
+    void modo_registro(const string& fich);
+
     /** @brief Añade un proceso en un procesador
      
       \pre no existe p en el procesador con ID = id
@@ -119,6 +531,16 @@ public:
     */
     void add_job_prc(const string& id, Proceso& p);
 
+    /** @brief Añade un bloque de procesos en un procesador
+
+      \pre <em>cierto</em>
+      \post Si existe el procesador con ID = id se han añadido los procesos de v
+      (consultar add_jobs() de la clase Procesador), en caso contrario se ha escrito
+      un mensaje de error por cada proceso de v
+      \coste Logarítmico (búsqueda en el map) más el coste de add_jobs() de Procesador
+    */
+    void add_jobs_prc(const string& id, const vector<Proceso>& v);
+
     /** @brief Elimina un proceso del procesador 
      
         \pre Existe un proceso en el procesador ,con ID = idprc, con ID = idjob
@@ -127,6 +549,16 @@ public:
     */
     void eliminar_job_prc(const string& idprc, int idjob);
 
+    /** @brief Elimina un conjunto de procesos de un procesador
+
+        \pre <em>cierto</em>
+        \post Si existe el procesador con ID = idprc, contiene sus procesos originales
+        menos los de idjobs (consultar eliminar_jobs() de la clase Procesador); en caso
+        contrario se ha escrito un mensaje de error por cada id de idjobs
+        \coste Logarítmico (búsqueda) más el coste de eliminar_jobs() de Procesador
+    */
+    void eliminar_jobs_prc(const string& idprc, const vector<int>& idjobs);
+
     /** @brief Avanza el tiempo del cluster
      
       \pre <em>cierto</em>
@@ -135,6 +567,59 @@ public:
     */
     void avanzar_tiempo_prc(int t);
  
+    /** @brief Empieza a avanzar el tiempo por eventos
+
+      \pre No se avanza por eventos
+      \post Se avanza por eventos: cada procesador con procesos tiene su próxima
+      finalización en plazos. Hasta cerrar_eventos() sólo se pueden usar
+      proximo_evento(), avanzar_hasta(), recibir_job(), las operaciones de colocación
+      especulativa y las consultoras que no escriben procesos
+      \coste Lineal respecto al número de procesadores por logarítmico
+    */
+    void abrir_eventos();
+
+    /** @brief Avanza el tiempo por eventos hasta un instante
+
+      \pre Se avanza por eventos, t >= reloj
+      \post Se han producido, por orden de instante, todas las finalizaciones de
+      procesos hasta t (incluido), el reloj es t y el resultado es el número de
+      procesos acabados. Sólo se han recorrido los procesadores con algún plazo <= t
+      \coste Por cada instante con finalizaciones, logarítmico más lineal respecto a
+      los procesos de los procesadores que acaban algún proceso
+    */
+    int avanzar_hasta(int t);
+
+    /** @brief Deja de avanzar el tiempo por eventos
+
+      \pre Se avanza por eventos
+      \post Los tiempos restantes de todos los procesos están referidos al reloj y
+      ya no se avanza por eventos
+      \coste Lineal respecto al número de procesos de los procesadores atrasados
+    */
+    void cerrar_eventos();
+
+    /** @brief Avanza el tiempo hasta la próxima finalización de un proceso
+
+      \pre <em>cierto</em>
+      \post Si hay procesos en ejecución, el reloj ha avanzado hasta la primera
+      finalización y se han eliminado todos los procesos que acaban en ese instante,
+      y devuelve true; en caso contrario el p.i. no cambia y devuelve false
+      \coste Lineal respecto al número de procesadores por logarítmico, más lineal
+      respecto al número de procesos
+    */
+    bool avanzar_evento();
+
+    /** @brief Consulta y olvida la memoria liberada
+
+      \pre <em>cierto</em>
+      \post El resultado es el mayor hueco de los procesadores donde ha acabado o se
+      ha eliminado algún proceso desde la llamada anterior (0 si no hay ninguno): un
+      proceso que no cabía en el cluster sólo puede caber ahora en uno de ellos. El
+      p.i. vuelve a no tener procesadores liberados
+      \coste Lineal respecto al número de procesadores liberados
+    */
+    int tomar_liberado();
+
     /** @brief Añade un clúster al clúster original
      
       \pre <em>cierto</em>
@@ -162,6 +647,125 @@ public:
     
     //Consultoras
 
+    /** @brief Comprueba los invariantes del cluster
+
+        \pre <em>cierto</em>
+        \post Se han comprobado los invariantes de cada procesador (consultar
+        comprobar() de la clase Procesador), su resumen de subárbol y su fila de la
+        tabla de huecos; por cada uno que no se cumple se ha escrito una línea
+        "error: invariante <id> <qué>". El resultado es cuántos fallan
+        \coste Lineal respecto al número total de procesos más el número de
+        procesadores por el número de clases de la tabla
+    */
+    int comprobar_invariantes() const;
+
+    /** @brief Consultora del reloj simulado
+
+      \pre <em>cierto</em>
+      \post El resultado es el tiempo total avanzado en el p.i.
+      \coste Constante
+  */
+    int consultar_tiempo() const;
+
+    /** @brief Consultora del mayor hueco del cluster
+
+      \pre <em>cierto</em>
+      \post El resultado es el tamaño del mayor hueco de todos los procesadores
+      \coste Constante
+  */
+    int max_hueco() const;
+
+    /** @brief Consultora de la memoria libre del cluster
+
+      \pre <em>cierto</em>
+      \post El resultado es la memoria no ocupada por procesos de todos los procesadores
+      \coste Constante
+  */
+    long long memoria_libre() const;
+
+    /** @brief Consultora del número de procesadores
+
+      \pre <em>cierto</em>
+      \post El resultado es el número de procesadores del cluster
+      \coste Constante
+  */
+    int num_procesadores() const;
+
+    /** @brief Consultora del resumen de un procesador
+
+      \pre <em>cierto</em>
+      \post Si existe el procesador con ID = id, procesos es su número de procesos,
+      huecos su número de huecos no vacíos y el resultado es cierto; si no, es falso
+      \coste Logarítmico más lineal sobre el número de huecos del procesador
+  */
+    bool resumen_prc(const string& id, int& procesos, int& huecos) const;
+
+    /** @brief Consultora del próximo evento
+
+      \pre Se avanza por eventos
+      \post El resultado es el instante de la próxima finalización de un proceso
+      (como mucho una cota inferior, en la que puede no acabar ninguno), -1 si no hay
+      procesos en ejecución
+      \coste Constante
+  */
+    long long proximo_evento() const;
+
+    /** @brief Operación de escritura de las métricas de compactación parcial
+
+      \pre <em>cierto</em>
+      \post Se ha escrito el número de compactaciones parciales hechas por recibir_job,
+      la memoria que desplazaron, la que habrían desplazado compactaciones completas
+      de los mismos procesadores (con cmp en el momento de cada compactación
+      parcial), y los procesos desplazados por las parciales y por las completas en
+      el canal standard de salida
+      \coste Constante
+  */
+    void escribir_metricas_compactacion() const;
+
+    /** @brief Operación de escritura de las métricas de rebalanceo
+
+      \pre <em>cierto</em>
+      \post Se ha escrito el número de rebalanceos hechos, el total de procesos migrados,
+      el total de memoria migrada, los procesos que recibir_job ha intentado colocar
+      fuera de un ámbito, cuántos habría aceptado sin los rebalanceos, cuántos ha
+      aceptado y los porcentajes de aceptación sin y con los rebalanceos en el canal
+      standard de salida
+      \coste Constante
+  */
+    void escribir_metricas_rebalanceo() const;
+
+    /** @brief Operación de escritura de las métricas de la colocación especulativa
+
+      \pre <em>cierto</em>
+      \post Se han escrito el número de procesos colocados con candidato especulado,
+      cuántos conservaron el candidato, cuántos se corrigieron con un procesador
+      cambiado y cuántos necesitaron una búsqueda completa, el porcentaje de conflictos
+      (corregidos y recalculados) y la aceleración estimada (búsquedas completas que
+      haría la colocación uno a uno entre búsquedas completas en serie hechas, contando
+      cada lote repartido entre hilos como una por hilo) en el canal standard de salida
+      \coste Constante
+  */
+    void escribir_metricas_especulacion() const;
+
+    /** @brief Operación de escritura del uso de un subárbol
+
+      \pre <em>cierto</em>
+      \post Si existe el procesador con ID = id se ha escrito el número de procesos,
+      la memoria ocupada, la memoria total y el mayor hueco de su subárbol en el canal
+      standard de salida; en caso contrario, un mensaje de error
+      \coste Constante en promedio
+  */
+    void escribir_uso(const string& id) const;
+
+    /** @brief Operación de escritura del uso del cluster
+
+      \pre <em>cierto</em>
+      \post Se ha escrito el número de procesos, la memoria ocupada, la memoria total
+      y el mayor hueco de todo el cluster en el canal standard de salida
+      \coste Constante
+  */
+    void escribir_uso() const;
+
     //Lectura y escritura
 
      /** @brief Operación de lectura
@@ -189,6 +793,17 @@ public:
       \coste Lineal sobre coste lineal respecto al número de procesos de todos los procesadores del cluster
     */
     void escribir_todos() const; 
+
+    /** @brief Operación de escritura de los procesadores que han cambiado
+
+      \pre <em>cierto</em>
+      \post Se han escrito, como en escribir_todos(), sólo los procesadores cuyos
+      procesos han cambiado desde la anterior llamada a esta operación (o desde su
+      creación), que dejan de tener cambios pendientes
+      \coste Lineal respecto al número de procesadores más lineal respecto al número
+      de procesos de los procesadores escritos
+    */
+    void escribir_cambios();
     /** @brief Operación de escritura de un procesador
 
       \pre <em>cierto</em>
@@ -197,6 +812,49 @@ public:
       \coste Lineal respecto respecto al número de procesos del procesador
     */
     void escribir_prc(const string& id, map<string,Procesador>::const_iterator& it) const; //escribe los procesos del procesador con ID=id
+
+    /** @brief Toma una copia de sólo lectura de la estructura
+
+      \pre <em>cierto</em>
+      \post El resultado es el árbol de procesadores del p.i. (comparte los nodos, que no cambian)
+      \coste Constante
+    */
+    BinTree<string> estructura() const;
+
+    /** @brief Operación de escritura de una copia de la estructura
+
+      \pre a es el resultado de estructura()
+      \post Se ha escrito en os lo que escribía escribir_est() al tomar a
+      \coste Lineal respecto al número de procesadores de a
+    */
+    static void escribir_est(ostream& os, const BinTree<string>& a);
+
+    /** @brief Toma una copia de sólo lectura de todos los procesadores
+
+      \pre <em>cierto</em>
+      \post s permite escribir lo mismo que escribir_todos() en el estado actual del p.i.
+      \coste Lineal respecto al número de procesadores más la copia de los procesos
+      de los procesadores sin texto formateado (consultar instantanea() de Procesador)
+    */
+    void instantanea_todos(Instantanea& s) const;
+
+    /** @brief Operación de escritura de una copia de todos los procesadores
+
+      \pre s es el resultado de instantanea_todos()
+      \post Se ha escrito en os lo que escribía escribir_todos() al tomar s
+      \coste Lineal respecto al tamaño del texto
+    */
+    static void escribir_todos(ostream& os, const Instantanea& s);
+
+    /** @brief Toma una copia de sólo lectura de un procesador
+
+      \pre <em>cierto</em>
+      \post Si existe el procesador con ID = id, s permite escribir lo mismo que
+      escribir_prc(id, it) y devuelve true; si no, se ha escrito un mensaje de error
+      y devuelve false
+      \coste Logarítmico más el de instantanea() de Procesador
+    */
+    bool instantanea_prc(const string& id, Procesador::Instantanea& s) const;
     
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,466 @@
+/** @file Comandos.cc
+    @brief Código del intérprete de comandos de la simulación
+*/
+
+#include "Comandos.hh"
+#include "Perfil.hh"
+#include "Lector.hh"
+#include "Lentos.hh"
+
+/** @brief Indica si un comando se puede encargar al hilo del clúster seleccionado:
+    sólo usa ese clúster y su área de espera una vez leídos sus datos */
+static bool encargable(const string& comando) {
+    return comando == "epc" or comando == "enviar_procesos_cluster" or comando == "epcs" or comando == "enviar_procesos_subarbol"
+        or comando == "at" or comando == "avanzar_tiempo" or comando == "ate" or comando == "avanzar_tiempo_evento"
+        or comando == "ehv" or comando == "ejecutar_hasta_vaciar" or comando == "cmc" or comando == "compactar_memoria_cluster"
+        or comando == "rbc" or comando == "rebalancear_cluster";
+}
+
+/** @brief Indica si un comando usa todos los clústeres o cambia un modo global, de modo
+    que antes hay que esperar a los comandos encargados a todos */
+static bool global(const string& comando) {
+    return comando == "epf" or comando == "enviar_procesos_federacion" or comando == "irf" or comando == "imprimir_resumen_federacion"
+        or comando == "bcf" or comando == "baja_cluster_federacion" or comando == "mpf" or comando == "modo_perfil"
+        or comando == "mla" or comando == "modo_lectura_asincrona" or comando == "mll" or comando == "modo_lentos"
+        or comando == "mhf" or comando == "modo_hilos_federacion";
+}
+
+void procesar_comandos(Federacion& f, Buzon* b, const function<void(Federacion&, const string&)>& tras) {
+    string comando;
+    unique_ptr<Lector> lector;  //con lector, las consultas se escriben en otro hilo
+    unique_ptr<Lentos> lentos;  //registro de comandos lentos
+    cin >> comando;
+    while (cin and comando != "fin") {
+        Cluster& c = f.cluster();
+        Area_espera& ae = f.espera();
+        bool perfil = Perfil::activado();
+        Perfil::Lectura ini;
+        if (perfil) Perfil::leer(ini);
+        Lentos* lento = lentos.get();   //el del inicio del comando, aunque el comando lo cambie
+        //con hilos por clúster (y un lector que ordene la salida), los comandos largos se
+        //encargan al hilo del seleccionado y los demás esperan a los clústeres que usan
+        bool en_hilo = f.con_hilos() and lector and not perfil and lento == nullptr and encargable(comando);
+        if (global(comando)) f.esperar_todos();
+        else if (not en_hilo and comando != "scf" and comando != "seleccionar_cluster_federacion"
+                 and comando != "acf" and comando != "alta_cluster_federacion") f.esperar();
+        auto ejecutar = [&f, &lector, en_hilo](const function<void()>& tarea) {
+            if (not en_hilo) tarea();
+            else {
+                Lector* l = lector.get();
+                shared_ptr<Lector::Encargo> e = l->encargar();     //la salida de tarea va en su sitio
+                f.encargar([l, e, tarea]() {
+                    Lector::asignar(e.get());
+                    tarea();
+                    Lector::asignar(nullptr);
+                    l->acabar_encargo(e);
+                });
+            }
+        };
+        if (lento != nullptr) lento->empezar();
+        if (b != nullptr) {
+            f.esperar();        //drenar modifica el área de espera seleccionada
+            while (b->drenar(ae, c.consultar_tiempo(), 1024) == 1024);  //por lotes, hasta vaciarlo
+        }
+        if (comando == "cc" or comando == "configurar_cluster") {   //1
+            cout << '#' << comando << endl;
+            c.leer();  
+        }
+        else if (comando == "mc" or comando == "modificar_cluster") {        //2
+            string id;
+            cin >> id;
+            Cluster c2;
+            c2.leer();
+            cout << '#' << comando << ' ' << id << endl;
+            c.añadir_cluster(c2, id);         
+        }
+
+        else if (comando == "ap" or comando == "alta_prioridad") {         //3      
+            string id_prior;
+            cin >> id_prior;
+            cout << '#' << comando << ' ' << id_prior << endl;
+            ae.add_prior(id_prior);      
+        }
+
+        else if (comando == "bp" or comando == "baja_prioridad") {         //4   
+            string id_prior;
+            cin >> id_prior;
+            cout << '#' << comando << ' ' << id_prior << endl;   
+            ae.eliminar_prior(id_prior);     
+        }
+        
+        else if (comando == "ape" or comando == "alta_proceso_espera") {       //5  
+            string id_prior;
+            cin >> id_prior;
+            Proceso p;
+            p.leer();
+            p.fijar_entrada(c.consultar_tiempo());
+            cout << '#' << comando << ' ' << id_prior << ' ' << p.consultar_ID() << endl;     
+            ae.add_job(p, id_prior); 
+        }
+
+        else if (comando == "apes" or comando == "alta_procesos_espera") {       //5b
+            string id_prior;
+            int n;
+            cin >> id_prior >> n;
+            if (n < 0) cout << '#' << comando << ' ' << id_prior << ' ' << n << endl << "error: numero de procesos negativo" << endl;
+            else {
+                vector<Proceso> v(n);
+                for (int i = 0; i < n; ++i) {
+                    v[i].leer();
+                    v[i].fijar_entrada(c.consultar_tiempo());
+                }
+                cout << '#' << comando << ' ' << id_prior << ' ' << n << endl;
+                ae.add_jobs(v, id_prior);
+            }
+        }
+
+        else if (comando == "app" or comando == "alta_proceso_procesador") {        //6
+            string id;
+            cin >> id;
+            Proceso p;
+            p.leer();
+            cout << '#' << comando << ' ' << id << ' ' << p.consultar_ID() << endl;
+            c.add_job_prc(id, p);             
+        }
+
+        else if (comando == "apps" or comando == "alta_procesos_procesador") {       //6b
+            string id;
+            int n;
+            cin >> id >> n;
+            if (n < 0) cout << '#' << comando << ' ' << id << ' ' << n << endl << "error: numero de procesos negativo" << endl;
+            else {
+                vector<Proceso> v(n);
+                for (int i = 0; i < n; ++i) v[i].leer();
+                cout << '#' << comando << ' ' << id << ' ' << n << endl;
+                c.add_jobs_prc(id, v);
+            }
+        }
+
+        else if (comando == "bpp" or comando == "baja_proceso_procesador") {        //7
+            string idprc; //id procesador
+            int idjob;     //id proceso
+            cin >> idprc >> idjob;
+            cout << '#' << comando << ' ' << idprc << ' ' << idjob << endl;
+            c.eliminar_job_prc(idprc,idjob); 
+            ae.enviar_liberado(c);
+        }
+
+        else if (comando == "bpps" or comando == "baja_procesos_procesador") {      //7b
+            string idprc;
+            int n;
+            cin >> idprc >> n;
+            if (n < 0) cout << '#' << comando << ' ' << idprc << ' ' << n << endl << "error: numero de procesos negativo" << endl;
+            else {
+                vector<int> idjobs(n);
+                for (int i = 0; i < n; ++i) cin >> idjobs[i];
+                cout << '#' << comando << ' ' << idprc << ' ' << n << endl;
+                c.eliminar_jobs_prc(idprc, idjobs);
+                ae.enviar_liberado(c);
+            }
+        }
+
+        else if (comando == "epc" or comando == "enviar_procesos_cluster") {        //8
+            int n;
+            cin >> n;
+            cout << '#' << comando << ' ' << n << endl;
+            ejecutar([&ae, &c, n]() { ae.enviar_job_a_cluster(n, c); });
+        }
+
+        else if (comando == "epcs" or comando == "enviar_procesos_subarbol") {     //8b
+            string id;
+            int n;
+            cin >> id >> n;
+            cout << '#' << comando << ' ' << id << ' ' << n << endl;
+            ejecutar([&ae, &c, id, n]() {
+                if (c.fijar_ambito(id)) {
+                    ae.enviar_job_a_cluster(n, c);
+                    c.quitar_ambito();
+                }
+            });
+        }
+
+        else if (comando == "at" or comando == "avanzar_tiempo") {     //9
+            int t;
+            cin >> t;
+            cout << '#' << comando << ' ' << t << endl;
+            ejecutar([&ae, &c, t]() {
+                c.avanzar_tiempo_prc(t);
+                ae.enviar_liberado(c);
+            });
+        }
+
+        else if (comando == "ate" or comando == "avanzar_tiempo_evento") {     //9b
+            cout << '#' << comando << endl;
+            ejecutar([&ae, &c]() {
+                if (not c.avanzar_evento()) cout << "error: no hay procesos en ejecucion" << endl;
+                else {
+                    cout << c.consultar_tiempo() << endl;
+                    ae.enviar_liberado(c);
+                }
+            });
+        }
+
+        else if (comando == "ehv" or comando == "ejecutar_hasta_vaciar") {     //9c
+            int t;
+            cin >> t;
+            cout << '#' << comando << ' ' << t << endl;
+            if (t <= 0) cout << "error: limite no positivo" << endl;
+            else {
+                ejecutar([&ae, &c, t]() {
+                    int eventos;
+                    ae.vaciar_espera(t, c, eventos);
+                    cout << c.consultar_tiempo() << ' ' << eventos << endl;
+                });
+            }
+        }
+
+        else if (comando == "ipri" or comando == "imprimir_prioridad") {   //10 
+            string id_prior;
+            cin >> id_prior;
+            cout << '#' << comando << ' ' << id_prior << endl;
+            map <string, Prioridad>::const_iterator it;
+            ae.escribir_prior(id_prior, it);    
+        }
+
+        else if (comando == "ipe" or comando == "imprimir_espera_prioridad") {   //10b
+            string id_prior;
+            cin >> id_prior;
+            cout << '#' << comando << ' ' << id_prior << endl;
+            ae.escribir_espera(id_prior);
+        }
+
+        else if (comando == "iae" or comando == "imprimir_area_espera") {   //11
+            cout << '#' << comando << endl;
+            if (lector) {
+                shared_ptr<Area_espera::Instantanea> s = make_shared<Area_espera::Instantanea>();
+                ae.instantanea(*s);
+                lector->consultar([s](ostream& os) { Area_espera::escribir(os, *s); });
+            }
+            else ae.escribir();  
+        }
+        else if (comando == "iaed" or comando == "imprimir_area_espera_cambios") {   //11b
+            cout << '#' << comando << endl;
+            ae.escribir_cambios();
+        }
+        else if (comando == "ipro" or comando == "imprimir_procesador") {   //12
+            string id;
+            cin >> id;
+            cout << '#' << comando << ' ' << id << endl;
+            if (lector) {
+                shared_ptr<Procesador::Instantanea> s = make_shared<Procesador::Instantanea>();
+                if (c.instantanea_prc(id, *s)) lector->consultar([s](ostream& os) { Procesador::escribir(os, *s); });
+            }
+            else {
+                map <string, Procesador>::const_iterator it;
+                c.escribir_prc(id, it);     
+            }
+        }
+        
+        else if (comando == "ipc" or comando == "imprimir_procesadores_cluster") {  //13
+            cout << '#' << comando << endl;
+            if (lector) {
+                shared_ptr<Cluster::Instantanea> s = make_shared<Cluster::Instantanea>();
+                c.instantanea_todos(*s);
+                lector->consultar([s](ostream& os) { Cluster::escribir_todos(os, *s); });
+            }
+            else c.escribir_todos();   
+        }
+        else if (comando == "ipcd" or comando == "imprimir_procesadores_cluster_cambios") {  //13b
+            cout << '#' << comando << endl;
+            c.escribir_cambios();
+        }
+        else if (comando == "iuso" or comando == "imprimir_uso_subarbol") {     //13c
+            string id;
+            cin >> id;
+            cout << '#' << comando << ' ' << id << endl;
+            c.escribir_uso(id);
+        }
+        else if (comando == "iec" or comando == "imprimir_estructura_cluster") {       //14
+            cout << '#' << comando << endl;
+            if (lector) {
+                BinTree<string> a = c.estructura();
+                lector->consultar([a](ostream& os) { Cluster::escribir_est(os, a); });
+            }
+            else c.escribir_est(); 
+        }
+        else if (comando == "cmp" or comando == "compactar_memoria_procesador") {    //15
+            string id;
+            cin >> id; 
+            cout << '#' << comando << ' ' << id << endl;
+            c.compactar_prc(id);
+                  
+        }
+    
+        else if (comando == "cmc" or comando == "compactar_memoria_cluster") {      //16
+            cout << '#' << comando << endl;
+            ejecutar([&c]() { c.compactar(); });
+        }
+
+        else if (comando == "mth" or comando == "modo_tabla_huecos") {     //16b
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            c.modo_tabla(b != 0);
+        }
+
+        else if (comando == "mhb" or comando == "modo_hilos_busqueda") {     //16c
+            int n;
+            cin >> n;
+            cout << '#' << comando << ' ' << n << endl;
+            c.modo_hilos(n);
+        }
+
+        else if (comando == "mcp" or comando == "modo_compactacion_parcial") {     //17
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            c.modo_compactacion_parcial(b != 0);
+        }
+
+        else if (comando == "imc" or comando == "imprimir_metricas_compactacion") {      //18
+            cout << '#' << comando << endl;
+            c.escribir_metricas_compactacion();
+        }
+
+        else if (comando == "rbc" or comando == "rebalancear_cluster") {      //19
+            cout << '#' << comando << endl;
+            ejecutar([&c]() {
+                int movs, antes, despues;
+                long long bytes;
+                c.rebalancear(0, -1, movs, bytes, antes, despues);
+                cout << movs << ' ' << bytes << ' ' << antes << ' ' << despues << endl;
+            });
+        }
+
+        else if (comando == "mrb" or comando == "modo_rebalanceo") {     //20
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            c.modo_rebalanceo(b != 0);
+        }
+
+        else if (comando == "irb" or comando == "imprimir_metricas_rebalanceo") {      //21
+            cout << '#' << comando << endl;
+            c.escribir_metricas_rebalanceo();
+        }
+
+        else if (comando == "mle" or comando == "modo_limite_espera") {     //22
+            int n;
+            cin >> n;
+            cout << '#' << comando << ' ' << n << endl;
+            if (n < 0) cout << "error: limite negativo" << endl;
+            else ae.limitar_espera(n);
+        }
+
+        else if (comando == "mre" or comando == "modo_registro_eventos") {     //23
+            string fich;
+            cin >> fich;
+            cout << '#' << comando << ' ' << fich << endl;
+            c.modo_registro(fich);
+        }
+
+        else if (comando == "mep" or comando == "modo_especulativo") {     //24
+            int k;
+            cin >> k;
+            cout << '#' << comando << ' ' << k << endl;
+            c.modo_especulativo(k);
+        }
+
+        else if (comando == "iep" or comando == "imprimir_metricas_especulacion") {      //25
+            cout << '#' << comando << endl;
+            c.escribir_metricas_especulacion();
+        }
+
+        else if (comando == "mae" or comando == "modo_auto_envio") {     //26
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            ae.modo_auto_envio(b != 0);
+        }
+
+        else if (comando == "acf" or comando == "alta_cluster_federacion") {     //27
+            string id;
+            cin >> id;
+            cout << '#' << comando << ' ' << id << endl;
+            f.añadir(id);
+        }
+
+        else if (comando == "bcf" or comando == "baja_cluster_federacion") {     //28
+            string id;
+            cin >> id;
+            cout << '#' << comando << ' ' << id << endl;
+            f.eliminar(id);
+        }
+
+        else if (comando == "scf" or comando == "seleccionar_cluster_federacion") {     //29
+            string id;
+            cin >> id;
+            cout << '#' << comando << ' ' << id << endl;
+            f.seleccionar(id);
+        }
+
+        else if (comando == "epf" or comando == "enviar_procesos_federacion") {     //30
+            int n;
+            cin >> n;
+            cout << '#' << comando << ' ' << n << endl;
+            f.enviar(n);
+        }
+
+        else if (comando == "irf" or comando == "imprimir_resumen_federacion") {     //31
+            cout << '#' << comando << endl;
+            f.escribir_resumen();
+        }
+
+        else if (comando == "mhf" or comando == "modo_hilos_federacion") {     //31b
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            if (b != 0 and not lector) lector.reset(new Lector());     //ordena la salida de los hilos
+            f.modo_hilos(b != 0);
+        }
+
+        else if (comando == "mpf" or comando == "modo_perfil") {     //32
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            Perfil::activar(b != 0);
+        }
+
+        else if (comando == "mla" or comando == "modo_lectura_asincrona") {     //33
+            int b;
+            cin >> b;
+            cout << '#' << comando << ' ' << b << endl;
+            if (b != 0) {
+                if (not lector) lector.reset(new Lector());
+            }
+            else lector.reset();        //escribe lo que quede pendiente
+        }
+
+        else if (comando == "mll" or comando == "modo_lentos") {     //34
+            long long u;
+            string nom;
+            cin >> u >> nom;
+            cout << '#' << comando << ' ' << u << ' ' << nom << endl;
+            lento = nullptr;
+            lentos.reset();
+            if (u >= 0) {
+                lentos.reset(new Lentos(u, nom));
+                if (not lentos->abierto()) {
+                    lentos.reset();
+                    cout << "error: no se puede abrir fichero" << endl;
+                }
+            }
+        }
+        if (perfil) Perfil::acumular_comando(comando, ini);
+        if (lento != nullptr) lento->acabar(f.cluster(), f.espera());
+        if (tras) {
+            f.esperar_todos();
+            tras(f, comando);
+        }
+        cin >> comando;
+    }
+    f.esperar_todos();          //antes de acabar con el lector que ordena su salida
+    lector.reset();
+    lentos.reset();
+    Perfil::escribir(cerr);
+}
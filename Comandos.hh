@@ -0,0 +1,32 @@
+/** @file Comandos.hh
+    @brief Especificación del intérprete de comandos de la simulación
+*/
+
+#ifndef COMANDOS_HH
+#define COMANDOS_HH
+
+#include "Federacion.hh"
+#include "Buzon.hh"
+#ifndef NO_DIAGRAM
+#include <functional>
+#endif
+using namespace std;
+
+/** @brief Ejecuta los comandos del canal standard de entrada sobre una federación de clusters
+
+    \pre f está inicializada
+    \post Se han ejecutado los comandos leídos hasta "fin" (o el final de la entrada)
+    y se ha escrito su salida en el canal standard de salida. Los comandos de
+    cluster y de área de espera se aplican al cluster seleccionado de f en el
+    momento de leerlos. Si b no es nulo, antes de cada comando se aplican al área
+    de espera seleccionada las peticiones depositadas en b. Con un hilo por clúster
+    (comando mhf), los comandos largos (epc, epcs, at, ate, ehv, cmc y rbc) se
+    ejecutan en el hilo del clúster seleccionado mientras se leen los siguientes, y
+    la salida sale en el orden de los comandos, igual que sin hilos. Al acabar, si se ha
+    activado el perfil (comando mpf), se escribe en el canal standard de error
+    (consultar escribir() de la clase Perfil). Si tras no es nulo, después de cada
+    comando se espera a todos los clústeres y se llama a tras con f y el comando
+*/
+void procesar_comandos(Federacion& f, Buzon* b = nullptr,
+                       const function<void(Federacion&, const string&)>& tras = nullptr);
+#endif
@@ -0,0 +1,159 @@
+/** @file Conjunto_ids.cc
+    @brief Código de la clase Conjunto_ids
+*/
+
+#include "Conjunto_ids.hh"
+
+const int Conjunto_ids::VACIO;
+
+Conjunto_ids::Conjunto_ids() {
+    en_disco = false;
+    cap = n = 0;
+    con_cero = false;
+    usos = 0;
+}
+
+int* Conjunto_ids::celdas() const {
+    if (en_disco) return reinterpret_cast<int*>(disco.datos());
+    return const_cast<int*>(mem.data());
+}
+
+long long Conjunto_ids::inicio(int id, long long c) {
+    unsigned int h = (unsigned int)id * 2654435769u;    //dispersión multiplicativa (Knuth)
+    return h & (c - 1);
+}
+
+void Conjunto_ids::usar() const {
+    if (en_disco and ++usos >= USOS) {
+        disco.soltar(0, disco.bytes());
+        usos = 0;
+    }
+}
+
+void Conjunto_ids::redimensionar(long long c, bool d) {
+    vector<int> mem2;
+    Proyeccion disco2;
+    int* t;                     //tabla nueva, con todas las celdas vacías (a 0)
+    if (d) {
+        disco2.redimensionar(c * sizeof(int));
+        t = reinterpret_cast<int*>(disco2.datos());
+    }
+    else {
+        mem2.assign(c, VACIO);
+        t = mem2.data();
+    }
+    int* a = celdas();
+    for (long long i = 0; i < cap; ++i) {
+        if (a[i] != VACIO) {
+            long long j = inicio(a[i], c);
+            while (t[j] != VACIO) j = (j + 1) & (c - 1);
+            t[j] = a[i];
+        }
+        if ((i + 1) % (1 << 16) == 0) {     //en disco, se sueltan las páginas por trozos
+            if (en_disco) disco.soltar(0, disco.bytes());
+            if (d) disco2.soltar(0, disco2.bytes());
+        }
+    }
+    if (d) disco2.soltar(0, disco2.bytes());
+    mem.swap(mem2);
+    disco.intercambiar(disco2);
+    en_disco = d;
+    cap = c;
+    usos = 0;
+}
+
+bool Conjunto_ids::insertar(int id) {
+    if (id == VACIO) {
+        bool nuevo = not con_cero;
+        con_cero = true;
+        return nuevo;
+    }
+    if (2 * (n + 1) > cap) redimensionar(cap == 0 ? 16 : 2 * cap, en_disco);
+    usar();
+    int* t = celdas();
+    long long j = inicio(id, cap);
+    while (t[j] != VACIO) {
+        if (t[j] == id) return false;
+        j = (j + 1) & (cap - 1);
+    }
+    t[j] = id;
+    ++n;
+    return true;
+}
+
+void Conjunto_ids::borrar(int id) {
+    if (id == VACIO) {
+        con_cero = false;
+        return;
+    }
+    if (n == 0) return;
+    usar();
+    int* t = celdas();
+    long long m = cap - 1;
+    long long j = inicio(id, cap);
+    while (t[j] != id) {
+        if (t[j] == VACIO) return;
+        j = (j + 1) & m;
+    }
+    //se vacía la celda y se retroceden los ids siguientes de la misma racha que
+    //quedarían separados de su celda inicial (sin marcas de borrado)
+    long long i = j;
+    while (true) {
+        t[i] = VACIO;
+        long long k = i;
+        while (true) {
+            k = (k + 1) & m;
+            if (t[k] == VACIO) {
+                --n;
+                if (cap > 16 and 8 * n < cap) redimensionar(cap / 2, en_disco);
+                return;
+            }
+            long long r = inicio(t[k], cap);
+            //t[k] puede ir a i si su celda inicial r no está en (i, k] (circularmente)
+            if (i <= k ? (r <= i or r > k) : (r <= i and r > k)) break;
+        }
+        t[i] = t[k];
+        i = k;
+    }
+}
+
+void Conjunto_ids::vaciar() {
+    vector<int>().swap(mem);
+    disco.cerrar();
+    cap = n = 0;
+    con_cero = false;
+    usos = 0;
+}
+
+void Conjunto_ids::cambiar_soporte(bool d) {
+    if (d == en_disco) return;
+    if (cap == 0) en_disco = d;
+    else redimensionar(cap, d);
+}
+
+bool Conjunto_ids::contiene(int id) const {
+    if (id == VACIO) return con_cero;
+    if (n == 0) return false;
+    usar();
+    const int* t = celdas();
+    long long j = inicio(id, cap);
+    while (t[j] != VACIO) {
+        if (t[j] == id) return true;
+        j = (j + 1) & (cap - 1);
+    }
+    return false;
+}
+
+long long Conjunto_ids::tamaño() const {
+    return n + (con_cero ? 1 : 0);
+}
+
+void Conjunto_ids::consultar_ids(vector<int>& v) const {
+    v.clear();
+    if (con_cero) v.push_back(VACIO);
+    const int* t = celdas();
+    for (long long i = 0; i < cap; ++i) {
+        if (t[i] != VACIO) v.push_back(t[i]);
+    }
+    if (en_disco) disco.soltar(0, disco.bytes());
+}
@@ -0,0 +1,163 @@
+/** @file Conjunto_ids.hh
+    @brief Especificación de la clase Conjunto_ids
+*/
+
+#ifndef CONJUNTO_IDS_HH
+#define CONJUNTO_IDS_HH
+
+#include "Proyeccion.hh"
+#ifndef NO_DIAGRAM
+#include <vector>
+#endif
+using namespace std;
+
+/** @class Conjunto_ids
+    @brief Conjunto de ids de procesos en una tabla de dispersión plana
+
+    Los ids se guardan directamente en una tabla de celdas (direccionamiento
+    abierto con sondeo lineal), sin ningún nodo por id: con la ocupación entre
+    1/8 y 1/2 de las celdas, cuesta entre 8 y 32 bytes por id, frente a los
+    unos 48 de un nodo de un conjunto ordenado. No guarda orden entre los ids.
+
+    La tabla puede estar en memoria o en un fichero temporal proyectado
+    (consultar cambiar_soporte()). En el fichero, cada USOS operaciones se sueltan
+    todas sus páginas, de forma que como mucho son residentes las que han tocado
+    las últimas USOS operaciones (normalmente una cada una), sea cual sea el número
+    de ids.
+*/
+class Conjunto_ids {
+
+private:
+    /** @brief Valor de una celda vacía (el id 0 se guarda aparte, en con_cero) */
+    static const int VACIO = 0;
+
+    /** @brief Operaciones entre dos liberaciones de las páginas del fichero */
+    static const int USOS = 256;
+
+    /** @brief Celdas de la tabla si está en memoria */
+    vector<int> mem;
+
+    /** @brief Celdas de la tabla si está en disco */
+    Proyeccion disco;
+
+    /** @brief Indica si la tabla está en disco */
+    bool en_disco;
+
+    /** @brief Número de celdas de la tabla, potencia de 2 (0 si no tiene) */
+    long long cap;
+
+    /** @brief Número de ids guardados en la tabla */
+    long long n;
+
+    /** @brief Indica si el id 0 está en el conjunto */
+    bool con_cero;
+
+    /** @brief Operaciones sobre el fichero desde la última liberación de sus páginas */
+    mutable int usos;
+
+    /** @brief Consulta las celdas de la tabla
+
+        \pre <em>cierto</em>
+        \post El resultado apunta a la primera celda de la tabla
+        \coste Constante
+    */
+    int* celdas() const;
+
+    /** @brief Celda en la que empieza la búsqueda de un id
+
+        \pre c es potencia de 2
+        \post El resultado es la celda inicial de id en una tabla de c celdas
+        \coste Constante
+    */
+    static long long inicio(int id, long long c);
+
+    /** @brief Cuenta una operación sobre la tabla
+
+        \pre <em>cierto</em>
+        \post Si la tabla está en disco y se han hecho USOS operaciones desde la
+        última liberación, se han soltado todas las páginas del fichero
+        \coste Constante amortizado
+    */
+    void usar() const;
+
+    /** @brief Cambia el número de celdas o el soporte de la tabla
+
+        \pre c es potencia de 2 y c > 2n
+        \post La tabla tiene c celdas, en disco si d y en memoria si no, con los mismos ids
+        \coste Lineal respecto al número de celdas anterior y nuevo
+    */
+    void redimensionar(long long c, bool d);
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un conjunto vacío, sin celdas, en memoria
+        \coste Constante
+    */
+    Conjunto_ids();
+
+    //Modificadoras
+
+    /** @brief Añade un id
+
+        \pre <em>cierto</em>
+        \post El p.i. contiene id; el resultado indica si no lo contenía
+        \coste Constante en promedio (amortizado)
+    */
+    bool insertar(int id);
+
+    /** @brief Borra un id
+
+        \pre <em>cierto</em>
+        \post El p.i. no contiene id; si queda ocupado menos de 1/8, se reducen las celdas
+        \coste Constante en promedio (amortizado)
+    */
+    void borrar(int id);
+
+    /** @brief Vacía el conjunto
+
+        \pre <em>cierto</em>
+        \post El p.i. está vacío y sin celdas (en el mismo soporte)
+        \coste Constante
+    */
+    void vaciar();
+
+    /** @brief Cambia el soporte de la tabla
+
+        \pre <em>cierto</em>
+        \post Los ids del p.i. no cambian; su tabla está en un fichero temporal si d
+        y en memoria si no
+        \coste Lineal respecto al número de celdas si cambia el soporte, constante si no
+    */
+    void cambiar_soporte(bool d);
+
+    //Consultoras
+
+    /** @brief Consulta si un id está en el conjunto
+
+        \pre <em>cierto</em>
+        \post El resultado indica si el p.i. contiene id
+        \coste Constante en promedio
+    */
+    bool contiene(int id) const;
+
+    /** @brief Consulta el número de ids del conjunto
+
+        \pre <em>cierto</em>
+        \post El resultado es el número de ids del p.i.
+        \coste Constante
+    */
+    long long tamaño() const;
+
+    /** @brief Consulta los ids del conjunto
+
+        \pre <em>cierto</em>
+        \post v contiene los ids del p.i., en un orden cualquiera
+        \coste Lineal respecto al número de celdas
+    */
+    void consultar_ids(vector<int>& v) const;
+};
+#endif
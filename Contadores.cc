@@ -0,0 +1,30 @@
+/** @file Contadores.cc
+    @brief Código de la clase Contadores
+*/
+
+#include "Contadores.hh"
+
+thread_local long long Contadores::bfs = 0;
+thread_local long long Contadores::colocados = 0;
+thread_local long long Contadores::eliminados = 0;
+thread_local long long Contadores::liberados = 0;
+thread_local long long Contadores::compactados = 0;
+thread_local long long Contadores::enviados = 0;
+thread_local long long Contadores::reencolados = 0;
+thread_local long long Contadores::huecos = 0;
+thread_local long long Contadores::traslados = 0;
+
+void Contadores::reiniciar() {
+    bfs = colocados = eliminados = liberados = compactados = enviados = reencolados = huecos = traslados = 0;
+}
+
+long long Contadores::total() {
+    return bfs + colocados + eliminados + liberados + compactados + enviados + reencolados
+           + huecos + traslados;
+}
+
+void Contadores::escribir(ostream& os) {
+    os << bfs << ' ' << colocados << ' ' << eliminados << ' ' << liberados << ' '
+       << compactados << ' ' << enviados << ' ' << reencolados << ' ' << huecos << ' '
+       << traslados << endl;
+}
@@ -0,0 +1,83 @@
+/** @file Contadores.hh
+    @brief Especificación de la clase Contadores
+*/
+
+#ifndef CONTADORES_HH
+#define CONTADORES_HH
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#endif
+using namespace std;
+
+/** @class Contadores
+    @brief Contadores de operaciones internas de la simulación
+
+    Cuentan el trabajo hecho por las operaciones cuyo coste depende de la entrada
+    (procesadores recorridos en las búsquedas, procesos recorridos al liberar y al
+    compactar, operaciones sobre los huecos, procesos enviados y reencolados...)
+    dentro de los bucles que lo hacen, de forma determinista e independiente de la
+    máquina. Cada hilo tiene los suyos: los comandos encargados al hilo de un
+    clúster de la federación (consultar modo_hilos() de la clase Federacion)
+    cuentan en los de ese hilo, no en los del hilo que lee los comandos.
+*/
+class Contadores {
+
+public:
+    /** @brief Procesadores recorridos por las búsquedas de procesador (bfs y variantes) */
+    static thread_local long long bfs;
+
+    /** @brief Procesos colocados en un procesador, más los ids recorridos al comprobar
+        un bloque de procesos contra los del procesador */
+    static thread_local long long colocados;
+
+    /** @brief Procesos eliminados de un procesador uno a uno (eliminar_job) */
+    static thread_local long long eliminados;
+
+    /** @brief Procesos recorridos al liberar memoria (avanzar el tiempo o eliminar en bloque) */
+    static thread_local long long liberados;
+
+    /** @brief Procesos recorridos al compactar memoria (completa o parcial) o al
+        calcular su coste */
+    static thread_local long long compactados;
+
+    /** @brief Procesos que el área de espera ha intentado enviar al cluster o ha
+        recorrido buscando cuál enviar */
+    static thread_local long long enviados;
+
+    /** @brief Procesos rechazados por el cluster y devueltos al final de su prioridad */
+    static thread_local long long reencolados;
+
+    /** @brief Consultas, inserciones y borrados en el mapa de huecos de un procesador */
+    static thread_local long long huecos;
+
+    /** @brief Procesos trasladados dentro de una cola de espera (entre memoria y
+        disco, o desplazados al quitar uno del medio) o desplazados en las columnas
+        de un procesador al colocar o quitar uno */
+    static thread_local long long traslados;
+
+    /** @brief Pone todos los contadores a 0
+
+        \pre <em>cierto</em>
+        \post Todos los contadores valen 0
+        \coste Constante
+    */
+    static void reiniciar();
+
+    /** @brief Suma de todos los contadores
+
+        \pre <em>cierto</em>
+        \post El resultado es la suma de todos los contadores, una medida del trabajo total
+        \coste Constante
+    */
+    static long long total();
+
+    /** @brief Operación de escritura
+
+        \pre <em>cierto</em>
+        \post Se han escrito los contadores en el orden en que están declarados en el canal os
+        \coste Constante
+    */
+    static void escribir(ostream& os);
+};
+#endif
@@ -0,0 +1,95 @@
+/** @file Federacion.cc
+    @brief Código de la clase Federacion
+*/
+
+#include "Federacion.hh"
+
+const string Federacion::PRINCIPAL = "principal";
+
+Federacion::Federacion() {
+    clusters[PRINCIPAL];        //construido en su sitio
+    actual = clusters.begin();
+    hilos = false;
+}
+
+void Federacion::añadir(const string& id) {
+    if (clusters.find(id) != clusters.end()) {
+        Miembro m;              //se leen los datos igualmente para no desincronizar la entrada
+        m.c.leer();
+        m.ae.leer();
+        cout << "error: ya existe cluster" << endl;
+    }
+    else {
+        Miembro& m = clusters[id];
+        m.c.leer();
+        m.ae.leer();
+        if (hilos) m.hilo.reset(new Trabajador());
+    }
+}
+
+void Federacion::eliminar(const string& id) {
+    map<string, Miembro>::iterator it = clusters.find(id);
+    if (it == clusters.end()) cout << "error: no existe cluster" << endl;
+    else if (it == actual) cout << "error: cluster seleccionado" << endl;
+    else clusters.erase(it);    //su hilo acaba los comandos encargados antes de destruirse
+}
+
+void Federacion::seleccionar(const string& id) {
+    map<string, Miembro>::iterator it = clusters.find(id);
+    if (it == clusters.end()) cout << "error: no existe cluster" << endl;
+    else actual = it;
+}
+
+void Federacion::modo_hilos(bool b) {
+    hilos = b;
+    for (map<string, Miembro>::iterator it = clusters.begin(); it != clusters.end(); ++it) {
+        if (not b) it->second.hilo.reset();
+        else if (not it->second.hilo) it->second.hilo.reset(new Trabajador());
+    }
+}
+
+void Federacion::encargar(const function<void()>& f) {
+    if (actual->second.hilo) actual->second.hilo->encargar(f);
+    else f();
+}
+
+void Federacion::esperar() {
+    if (actual->second.hilo) actual->second.hilo->esperar();
+}
+
+void Federacion::esperar_todos() {
+    for (map<string, Miembro>::iterator it = clusters.begin(); it != clusters.end(); ++it) {
+        if (it->second.hilo) it->second.hilo->esperar();
+    }
+}
+
+bool Federacion::con_hilos() const {
+    return hilos;
+}
+
+void Federacion::enviar(int n) {
+    vector<Cluster*> v;
+    v.reserve(clusters.size());
+    for (map<string, Miembro>::iterator it = clusters.begin(); it != clusters.end(); ++it) v.push_back(&it->second.c);
+    actual->second.ae.enviar_job_a_federacion(n, v, actual->second.c.consultar_tiempo());
+}
+
+Cluster& Federacion::cluster() {
+    return actual->second.c;
+}
+
+Area_espera& Federacion::espera() {
+    return actual->second.ae;
+}
+
+void Federacion::leer() {
+    actual->second.c.leer();
+    actual->second.ae.leer();
+}
+
+void Federacion::escribir_resumen() const {
+    for (map<string, Miembro>::const_iterator it = clusters.begin(); it != clusters.end(); ++it) {
+        cout << it->first << (it == map<string, Miembro>::const_iterator(actual) ? " * " : " ");
+        it->second.c.escribir_uso();
+    }
+}
@@ -0,0 +1,198 @@
+/** @file Federacion.hh
+    @brief Especificación de la clase Federacion
+*/
+
+#ifndef FEDERACION_HH
+#define FEDERACION_HH
+
+#include "Cluster.hh"
+#include "Area_espera.hh"
+#include "Trabajador.hh"
+#ifndef NO_DIAGRAM
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#endif
+using namespace std;
+
+/** @class Federacion
+    @brief Conjunto de clústeres con nombre, cada uno con su propia área de espera
+
+    Cada clúster tiene su propio reloj simulado. Siempre hay un clúster
+    seleccionado, al que se dirigen los comandos de clúster y de área de espera;
+    al crearse la federación contiene sólo el clúster PRINCIPAL, que es el
+    seleccionado.
+
+    Con los hilos activados (consultar modo_hilos()), cada clúster tiene un hilo
+    propio al que se le pueden encargar comandos: los de clústeres distintos se
+    ejecutan a la vez y los de uno mismo, en orden.
+*/
+class Federacion {
+
+public:
+    /** @brief Nombre del clúster leído con la configuración inicial */
+    static const string PRINCIPAL;
+
+private:
+    /** @brief Clúster de la federación con su área de espera */
+    struct Miembro {
+        Cluster c;
+        Area_espera ae;
+        unique_ptr<Trabajador> hilo;    //nulo sin hilos
+    };
+
+    /** @brief Clústeres de la federación ordenados por nombre
+
+      Cluster y Area_espera guardan iteradores a sus propios contenedores: los
+      miembros se construyen en su sitio y nunca se copian */
+    map<string, Miembro> clusters;
+
+    /** @brief Clúster seleccionado */
+    map<string, Miembro>::iterator actual;
+
+    /** @brief Indica si cada clúster tiene su propio hilo */
+    bool hilos;
+
+    Federacion(const Federacion&) = delete;
+    Federacion& operator=(const Federacion&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es una federación con el clúster PRINCIPAL, sin
+        procesadores ni prioridades, seleccionado
+        \coste Constante
+    */
+    Federacion();
+
+    //Modificadoras
+
+    /** @brief Añade un clúster a la federación
+
+        \pre Hay preparados en el canal standard de entrada los datos de un clúster
+        y de sus prioridades (como leer())
+        \post Se han leído los datos; si no existía un clúster con nombre id, el p.i.
+        contiene un clúster nuevo con ese nombre y esos datos, en caso contrario se
+        ha escrito un mensaje de error
+        \coste Logarítmico más lineal respecto a los datos leídos
+    */
+    void añadir(const string& id);
+
+    /** @brief Elimina un clúster de la federación
+
+        \pre <em>cierto</em>
+        \post Si existe el clúster id y no es el seleccionado, el p.i. ya no lo
+        contiene; en caso contrario se ha escrito un mensaje de error
+        \coste Logarítmico más lineal respecto al tamaño del clúster eliminado
+    */
+    void eliminar(const string& id);
+
+    /** @brief Selecciona un clúster
+
+        \pre <em>cierto</em>
+        \post Si existe el clúster id, pasa a ser el seleccionado; en caso contrario
+        se ha escrito un mensaje de error
+        \coste Logarítmico
+    */
+    void seleccionar(const string& id);
+
+    /** @brief Activa o desactiva un hilo por clúster
+
+        \pre <em>cierto</em>
+        \post Si b, cada clúster del p.i. (y cada uno que se añada) tiene su propio
+        hilo para encargar(); si no, se han esperado los comandos encargados y ya
+        no hay hilos
+        \coste Lineal respecto al número de clústeres más el de esperar_todos()
+    */
+    void modo_hilos(bool b);
+
+    /** @brief Encarga un comando al clúster seleccionado
+
+        \pre f sólo usa el clúster seleccionado, su área de espera y datos propios
+        \post Con hilos, f se ejecutará en el hilo del clúster seleccionado después de
+        los comandos que se le han encargado antes; sin hilos, se ha ejecutado f
+        \coste Constante amortizado con hilos; el de f sin hilos
+    */
+    void encargar(const function<void()>& f);
+
+    /** @brief Espera a los comandos encargados al clúster seleccionado
+
+        \pre <em>cierto</em>
+        \post Se han ejecutado todos los comandos encargados al clúster seleccionado
+        \coste El de los comandos pendientes del clúster seleccionado
+    */
+    void esperar();
+
+    /** @brief Espera a los comandos encargados a todos los clústeres
+
+        \pre <em>cierto</em>
+        \post Se han ejecutado todos los comandos encargados
+        \coste Lineal respecto al número de clústeres más el de los comandos pendientes
+    */
+    void esperar_todos();
+
+    /** @brief Envía procesos del área de espera seleccionada a toda la federación
+
+        \pre n > 0
+        \post Se han intentado enviar n procesos del área de espera del clúster
+        seleccionado como con enviar_job_a_cluster(), pero cada proceso se ofrece al
+        clúster de la federación en el que mejor cabe según su resumen: el de menor
+        mayor hueco que no es menor que la memoria del proceso, en caso de empate
+        el de más memoria libre y luego el de menor nombre
+        \coste El de enviar_job_a_federacion() de la clase Area_espera
+    */
+    void enviar(int n);
+
+    /** @brief Consulta el clúster seleccionado
+
+        \pre <em>cierto</em>
+        \post El resultado es el clúster seleccionado
+        \coste Constante
+    */
+    Cluster& cluster();
+
+    /** @brief Consulta el área de espera del clúster seleccionado
+
+        \pre <em>cierto</em>
+        \post El resultado es el área de espera del clúster seleccionado
+        \coste Constante
+    */
+    Area_espera& espera();
+
+    //Lectura y escritura
+
+    /** @brief Operación de lectura
+
+        \pre Hay preparados en el canal standard de entrada los datos de un clúster
+        y de sus prioridades
+        \post El clúster seleccionado y su área de espera pasan a tener los datos leídos
+        \coste Lineal respecto a los datos leídos
+    */
+    void leer();
+
+    /** @brief Operación de escritura del resumen de la federación
+
+        \pre <em>cierto</em>
+        \post Se ha escrito, por orden de nombre, el nombre de cada clúster seguido
+        de su número de procesos, su memoria ocupada, su memoria total y su mayor
+        hueco en el canal standard de salida; el seleccionado va marcado con '*'
+        \coste Lineal respecto al número de clústeres
+    */
+    void escribir_resumen() const;
+
+    //Consultoras
+
+    /** @brief Consulta si cada clúster tiene su propio hilo
+
+        \pre <em>cierto</em>
+        \post El resultado indica si están activados los hilos (consultar modo_hilos())
+        \coste Constante
+    */
+    bool con_hilos() const;
+};
+#endif
@@ -0,0 +1,69 @@
+/** @file Filtro_ids.cc
+    @brief Código de la clase Filtro_ids
+*/
+
+#include "Filtro_ids.hh"
+
+Filtro_ids::Filtro_ids() {
+    total = 0;
+}
+
+void Filtro_ids::contadores(int id, int pos[K]) {
+    unsigned long long h = (unsigned int)id;        //mezcla de splitmix64
+    h += 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    const int por_bloque = 2 * BLOQUE;              //contadores por bloque
+    int b = (h % (BYTES / BLOQUE)) * por_bloque;
+    h /= BYTES / BLOQUE;
+    for (int k = 0; k < K; ++k) {                   //7 bits por contador dentro del bloque
+        pos[k] = b + h % por_bloque;
+        h /= por_bloque;
+    }
+}
+
+int Filtro_ids::valor(int i) const {
+    return (c[i / 2] >> (4 * (i % 2))) & 15;
+}
+
+void Filtro_ids::sumar(int i, int d) {
+    int v = valor(i);
+    if (v == 15) return;        //saturado: ya no se sabe cuántos ids lo usan
+    if (d > 0) c[i / 2] += 1 << (4 * (i % 2));
+    else c[i / 2] -= 1 << (4 * (i % 2));
+}
+
+void Filtro_ids::insertar(int id) {
+    if (c.empty()) c.assign(BYTES, 0);
+    int pos[K];
+    contadores(id, pos);
+    for (int k = 0; k < K; ++k) sumar(pos[k], 1);
+    ++total;
+}
+
+void Filtro_ids::borrar(int id) {
+    int pos[K];
+    contadores(id, pos);
+    for (int k = 0; k < K; ++k) sumar(pos[k], -1);
+    if (--total == 0) vaciar();
+}
+
+void Filtro_ids::vaciar() {
+    vector<unsigned char>().swap(c);
+    total = 0;
+}
+
+bool Filtro_ids::quiza(int id) const {
+    if (c.empty()) return false;
+    int pos[K];
+    contadores(id, pos);
+    for (int k = 0; k < K; ++k) {
+        if (valor(pos[k]) == 0) return false;
+    }
+    return true;
+}
+
+long long Filtro_ids::tamaño() const {
+    return total;
+}
@@ -0,0 +1,122 @@
+/** @file Filtro_ids.hh
+    @brief Especificación de la clase Filtro_ids
+*/
+
+#ifndef FILTRO_IDS_HH
+#define FILTRO_IDS_HH
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#endif
+using namespace std;
+
+/** @class Filtro_ids
+    @brief Filtro de Bloom con contadores, por bloques, de los ids de procesos
+
+    Ocupa siempre BYTES bytes, sea cual sea el número de ids: contadores de 4 bits
+    agrupados en bloques de 64 bytes (una línea de caché), y cada id incrementa K
+    contadores de un mismo bloque. Sólo responde "quizá": un id que está en el
+    filtro siempre se da como posible, y uno que no está puede darse como posible
+    (falso positivo), con más probabilidad cuantos más ids contiene. Un contador
+    que llega a 15 ya no cambia, para no producir nunca falsos negativos al borrar.
+*/
+class Filtro_ids {
+
+private:
+    /** @brief Memoria del filtro en bytes (potencia de 2, múltiplo de BLOQUE) */
+    static const int BYTES = 1 << 15;
+
+    /** @brief Bytes por bloque */
+    static const int BLOQUE = 64;
+
+    /** @brief Contadores por id */
+    static const int K = 4;
+
+    /** @brief Contadores de 4 bits, dos por byte (vacío si el filtro está vacío) */
+    vector<unsigned char> c;
+
+    /** @brief Número de ids del filtro */
+    long long total;
+
+    /** @brief Calcula los contadores de un id
+
+        \pre <em>cierto</em>
+        \post pos contiene los K contadores de id (dentro de un mismo bloque)
+        \coste Constante
+    */
+    static void contadores(int id, int pos[K]);
+
+    /** @brief Consulta un contador
+
+        \pre c no es vacío, 0 <= i < 2 * BYTES
+        \post El resultado es el valor del contador i
+        \coste Constante
+    */
+    int valor(int i) const;
+
+    /** @brief Suma d a un contador no saturado
+
+        \pre c no es vacío, 0 <= i < 2 * BYTES, d = 1 o d = -1, el contador i no
+        vale 0 si d = -1
+        \post Si el contador i valía menos de 15, se le ha sumado d
+        \coste Constante
+    */
+    void sumar(int i, int d);
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un filtro vacío, sin memoria reservada
+        \coste Constante
+    */
+    Filtro_ids();
+
+    //Modificadoras
+
+    /** @brief Añade un id
+
+        \pre <em>cierto</em>
+        \post El p.i. contiene id (una vez más si ya lo contenía)
+        \coste Constante (reserva BYTES bytes la primera vez)
+    */
+    void insertar(int id);
+
+    /** @brief Borra un id
+
+        \pre id está en el p.i.
+        \post El p.i. contiene id una vez menos
+        \coste Constante
+    */
+    void borrar(int id);
+
+    /** @brief Vacía el filtro
+
+        \pre <em>cierto</em>
+        \post El p.i. está vacío y sin memoria reservada
+        \coste Constante
+    */
+    void vaciar();
+
+    //Consultoras
+
+    /** @brief Consulta si un id puede estar en el filtro
+
+        \pre <em>cierto</em>
+        \post Si id está en el p.i., el resultado es cierto; si no, es falso salvo
+        por un falso positivo
+        \coste Constante
+    */
+    bool quiza(int id) const;
+
+    /** @brief Consulta el número de ids del filtro
+
+        \pre <em>cierto</em>
+        \post El resultado es el número de ids del p.i.
+        \coste Constante
+    */
+    long long tamaño() const;
+};
+#endif
@@ -0,0 +1,59 @@
+/** @file Grupo_hilos.cc
+    @brief Código de la clase Grupo_hilos
+*/
+
+#include "Grupo_hilos.hh"
+
+Grupo_hilos::Grupo_hilos(int n) {
+    partes = 0;
+    ronda = 0;
+    pendientes = 0;
+    acabar = false;
+    for (int t = 1; t < n; ++t) hilos.push_back(thread(&Grupo_hilos::trabajar, this, t));
+}
+
+Grupo_hilos::~Grupo_hilos() {
+    {
+        lock_guard<mutex> g(m);
+        acabar = true;
+    }
+    cv_ronda.notify_all();
+    for (int i = 0; i < hilos.size(); ++i) hilos[i].join();
+}
+
+void Grupo_hilos::trabajar(int t) {
+    long long vista = 0;        //última ronda atendida
+    unique_lock<mutex> l(m);
+    while (true) {
+        while (ronda == vista and not acabar) cv_ronda.wait(l);
+        if (acabar) break;
+        vista = ronda;
+        if (t < partes) {
+            l.unlock();
+            tarea(t);           //tarea no cambia hasta que pendientes llega a 0
+            l.lock();
+            if (--pendientes == 0) cv_hecho.notify_one();
+        }
+    }
+}
+
+void Grupo_hilos::ejecutar(int k, const function<void(int)>& f) {
+    lock_guard<mutex> u(uso);
+    if (k > 1) {
+        lock_guard<mutex> g(m);
+        tarea = f;
+        partes = k;
+        pendientes = k - 1;
+        ++ronda;
+    }
+    if (k > 1) cv_ronda.notify_all();
+    f(0);
+    if (k > 1) {
+        unique_lock<mutex> l(m);
+        while (pendientes > 0) cv_hecho.wait(l);
+    }
+}
+
+int Grupo_hilos::tamaño() const {
+    return hilos.size() + 1;
+}
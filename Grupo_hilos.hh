@@ -0,0 +1,110 @@
+/** @file Grupo_hilos.hh
+    @brief Especificación de la clase Grupo_hilos
+*/
+
+#ifndef GRUPO_HILOS_HH
+#define GRUPO_HILOS_HH
+
+#ifndef NO_DIAGRAM
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#endif
+using namespace std;
+
+/** @class Grupo_hilos
+    @brief Hilos de trabajo persistentes para repartir una tarea en partes
+
+    Los hilos se crean una sola vez, al crear el grupo, y esperan dormidos a que
+    llegue una tarea; cada ejecución sólo les avisa y espera a que acaben, sin
+    crear ni destruir hilos. El hilo que pide la ejecución hace la parte 0.
+*/
+class Grupo_hilos {
+
+private:
+    /** @brief Hilos de trabajo: el i hace la parte i + 1 */
+    vector<thread> hilos;
+
+    /** @brief Exclusión mutua sobre tarea, partes, ronda, pendientes y acabar */
+    mutex m;
+
+    /** @brief Aviso a los hilos de que hay una ronda nueva o de que deben acabar */
+    condition_variable cv_ronda;
+
+    /** @brief Aviso al que pide la ejecución de que ya no quedan partes pendientes */
+    condition_variable cv_hecho;
+
+    /** @brief Una ejecución a la vez (el grupo puede estar compartido) */
+    mutex uso;
+
+    /** @brief Tarea de la ronda actual */
+    function<void(int)> tarea;
+
+    /** @brief Número de partes de la ronda actual */
+    int partes;
+
+    /** @brief Número de la ronda actual (cambia con cada ejecución) */
+    long long ronda;
+
+    /** @brief Partes de la ronda actual que aún hacen los hilos de trabajo */
+    int pendientes;
+
+    /** @brief Indica a los hilos que deben acabar */
+    bool acabar;
+
+    /** @brief Bucle del hilo de trabajo que hace la parte t
+
+        \pre t >= 1
+        \post Ha hecho la parte t de cada ronda con más de t partes hasta que se pide acabar
+        \coste Lineal respecto al trabajo de sus partes
+    */
+    void trabajar(int t);
+
+    Grupo_hilos(const Grupo_hilos&) = delete;
+    Grupo_hilos& operator=(const Grupo_hilos&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora con el número de hilos.
+
+        \pre n >= 1
+        \post El resultado es un grupo de n hilos contando el que pide las
+        ejecuciones (se crean n - 1 hilos de trabajo)
+        \coste Lineal respecto a n
+    */
+    explicit Grupo_hilos(int n);
+
+    /** @brief Destructora.
+
+        \pre No hay ninguna ejecución en curso
+        \post Los hilos de trabajo han acabado
+        \coste Lineal respecto al número de hilos
+    */
+    ~Grupo_hilos();
+
+    //Modificadoras
+
+    /** @brief Ejecuta una tarea repartida en partes
+
+        \pre 1 <= k <= tamaño(); f(t) sólo comparte con las otras partes datos que
+        ninguna modifica (o que cada parte modifica en posiciones propias)
+        \post Se ha hecho f(t) para cada t en [0, k): la parte 0 en el hilo que llama
+        y las demás en los hilos de trabajo, en paralelo
+        \coste El de la parte más lenta más un aviso y una espera por ejecución
+    */
+    void ejecutar(int k, const function<void(int)>& f);
+
+    //Consultoras
+
+    /** @brief Consulta el número de hilos del grupo
+
+        \pre <em>cierto</em>
+        \post El resultado es el número de hilos del p.i., contando el que pide las ejecuciones
+        \coste Constante
+    */
+    int tamaño() const;
+};
+#endif
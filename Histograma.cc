@@ -0,0 +1,54 @@
+/** @file Histograma.cc
+    @brief Código de la clase Histograma
+*/
+
+#include "Histograma.hh"
+
+Histograma::Histograma() {
+    total = 0;
+    maximo = 0;
+}
+
+int Histograma::indice(int v) {
+    if (v < SUB) return v;                  //los valores pequeños tienen cubeta propia
+    int k = 31 - __builtin_clz(v);          //potencia de 2 de v (k >= 4)
+    return SUB * (k - 3) + ((v >> (k - 4)) - SUB);
+}
+
+int Histograma::valor(int i) {
+    if (i < SUB) return i;
+    int k = i / SUB + 3;
+    int bajo = (SUB + i % SUB) << (k - 4);
+    return bajo + (1 << (k - 4)) - 1;
+}
+
+void Histograma::registrar(int v) {
+    if (v < 0) v = 0;
+    if (cub.empty()) cub = vector<long long>(NCUB, 0);     //se reserva al primer registro
+    ++cub[indice(v)];
+    ++total;
+    if (v > maximo) maximo = v;
+}
+
+int Histograma::percentil(double q) const {
+    if (total == 0) return 0;
+    long long rango = (long long)(q * total);
+    if (rango < q * total) ++rango;         //redondeo hacia arriba
+    if (rango < 1) rango = 1;
+    long long acum = 0;
+    int i = 0;
+    while (acum + cub[i] < rango) {
+        acum += cub[i];
+        ++i;
+    }
+    int v = valor(i);
+    return v < maximo ? v : maximo;
+}
+
+long long Histograma::consultar_total() const {
+    return total;
+}
+
+void Histograma::escribir() const {
+    cout << total << ' ' << percentil(0.5) << ' ' << percentil(0.99) << ' ' << maximo << endl;
+}
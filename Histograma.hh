@@ -0,0 +1,104 @@
+/** @file Histograma.hh
+    @brief Especificación de la clase Histograma
+*/
+
+#ifndef HISTOGRAMA_HH
+#define HISTOGRAMA_HH
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#include <vector>
+#endif
+using namespace std;
+
+/** @class Histograma
+    @brief Histograma de tiempos de espera con memoria constante (estilo HDR)
+
+    Los valores se agrupan en cubetas logarítmico-lineales: cada potencia de 2
+    se divide en SUB cubetas de igual anchura, de forma que el error relativo
+    de los percentiles está acotado por 1/SUB. El número de cubetas es fijo y
+    no depende de la cantidad de valores registrados.
+*/
+class Histograma {
+
+private:
+    /** @brief Número de subcubetas por potencia de 2 (los valores menores son exactos) */
+    static const int SUB = 16;
+
+    /** @brief Número total de cubetas (suficiente para cualquier int no negativo) */
+    static const int NCUB = SUB * 28;
+
+    /** @brief Contador de valores por cubeta, vacío hasta el primer registro */
+    vector<long long> cub;
+
+    /** @brief Número de valores registrados */
+    long long total;
+
+    /** @brief Valor máximo registrado (exacto) */
+    int maximo;
+
+    /** @brief Cubeta a la que pertenece el valor v
+        \pre v >= 0
+        \post El resultado es el índice de la cubeta de v
+        \coste Constante
+    */
+    static int indice(int v);
+
+    /** @brief Mayor valor equivalente de una cubeta
+        \pre 0 <= i < NCUB
+        \post El resultado es el mayor valor que pertenece a la cubeta i
+        \coste Constante
+    */
+    static int valor(int i);
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un histograma sin valores
+        \coste Constante
+    */
+    Histograma();
+
+    //Modificadoras
+
+    /** @brief Registra un valor en el histograma
+
+        \pre <em>cierto</em>
+        \post El p.i. contiene el valor v (los negativos cuentan como 0)
+        \coste Constante
+    */
+    void registrar(int v);
+
+    //Consultoras
+
+    /** @brief Consulta un percentil de los valores registrados
+
+        \pre 0 < q <= 1
+        \post El resultado es el menor valor (con la precisión de las cubetas) que
+        es mayor o igual que una fracción q de los valores registrados, 0 si no hay valores
+        \coste Constante (recorrido de las cubetas, de tamaño fijo)
+    */
+    int percentil(double q) const;
+
+    /** @brief Consulta el número de valores registrados
+        \pre <em>cierto</em>
+        \post El resultado es el número de valores registrados en el p.i.
+        \coste Constante
+    */
+    long long consultar_total() const;
+
+    //Lectura y escritura
+
+    /** @brief Operación de escritura
+
+      \pre <em>cierto</em>
+      \post Se han escrito el número de valores, el percentil 50, el percentil 99 y el
+      máximo del p.i. en el canal standard de salida.
+      \coste Constante
+    */
+    void escribir() const;
+};
+#endif
@@ -0,0 +1,63 @@
+/** @file Indice_memoria.cc
+    @brief Código de la clase Indice_memoria
+*/
+
+#include "Indice_memoria.hh"
+#include <climits>
+#include <algorithm>
+
+Indice_memoria::Indice_memoria() {
+    base = 0;
+    cap = 0;
+}
+
+void Indice_memoria::construir(long long b, const deque<Proceso>& d) {
+    base = b;
+    cap = 16;
+    while (cap < 2 * d.size()) cap *= 2;
+    t.assign(2 * cap, INT_MAX);
+    for (int i = 0; i < d.size(); ++i) t[cap + i] = d[i].consultar_MEM();
+    for (int k = cap - 1; k > 0; --k) t[k] = min(t[2 * k], t[2 * k + 1]);
+}
+
+void Indice_memoria::poner(long long s, int m) {
+    int k = cap + (s - base);
+    t[k] = m;
+    for (k /= 2; k > 0; k /= 2) t[k] = min(t[2 * k], t[2 * k + 1]);
+}
+
+void Indice_memoria::quitar(long long s) {
+    poner(s, INT_MAX);
+}
+
+void Indice_memoria::vaciar() {
+    vector<int>().swap(t);
+    base = 0;
+    cap = 0;
+}
+
+bool Indice_memoria::cabe(long long s) const {
+    return s >= base and s < base + cap;
+}
+
+bool Indice_memoria::contiene(long long s) const {
+    return t[cap + (s - base)] != INT_MAX;
+}
+
+int Indice_memoria::descender(int k, int h) const {
+    while (k < cap) k = (t[2 * k] <= h) ? 2 * k : 2 * k + 1;
+    return k - cap;
+}
+
+long long Indice_memoria::buscar(long long s, int h) const {
+    if (s < base) s = base;
+    if (cap == 0 or s >= base + cap) return -1;
+    //se sube desde la hoja de s: cada hermano derecho no visitado cubre el tramo siguiente
+    int k = cap + (s - base);
+    if (t[k] <= h) return s;
+    while (k > 1) {
+        if (k % 2 == 0 and t[k + 1] <= h) return base + descender(k + 1, h);
+        k /= 2;
+    }
+    return -1;
+}
@@ -0,0 +1,119 @@
+/** @file Indice_memoria.hh
+    @brief Especificación de la clase Indice_memoria
+*/
+
+#ifndef INDICE_MEMORIA_HH
+#define INDICE_MEMORIA_HH
+
+#include "Proceso.hh"
+#ifndef NO_DIAGRAM
+#include <deque>
+#include <vector>
+#endif
+using namespace std;
+
+/** @class Indice_memoria
+    @brief Índice por memoria de una cola de procesos
+
+    Cada proceso de la cola tiene un número de orden (el de la posición 0 de la cola
+    en construir() es b, el siguiente b + 1...). El índice es un árbol de segmentos
+    con la memoria mínima de los procesos indexados de cada tramo de números de
+    orden [base, base + cap), de forma que el primer proceso a partir de un número
+    de orden que cabe en un hueco de tamaño h se encuentra sin visitar los que no
+    caben. Ocupa 2 cap enteros, entre 4 y 8 por proceso indexado.
+*/
+class Indice_memoria {
+
+private:
+    /** @brief Árbol: la hoja base + i está en cap + i, y cada nodo k tiene el mínimo
+        de 2k y 2k + 1 (INT_MAX si no hay ningún proceso) */
+    vector<int> t;
+
+    /** @brief Número de orden de la primera hoja */
+    long long base;
+
+    /** @brief Número de hojas, potencia de 2 (0 si no hay árbol) */
+    int cap;
+
+    /** @brief Primera hoja de un subárbol cuyo mínimo es <= h
+
+        \pre k es un nodo con t[k] <= h
+        \post El resultado es la primera hoja (como índice de hoja) del subárbol de k con valor <= h
+        \coste Logarítmico
+    */
+    int descender(int k, int h) const;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un índice vacío, sin árbol
+        \coste Constante
+    */
+    Indice_memoria();
+
+    //Modificadoras
+
+    /** @brief Indexa una cola completa
+
+        \pre <em>cierto</em>
+        \post El p.i. indexa los procesos de d con números de orden b, b + 1...,
+        con hojas al menos para el doble de procesos que d
+        \coste Lineal respecto al tamaño de d
+    */
+    void construir(long long b, const deque<Proceso>& d);
+
+    /** @brief Indexa un proceso
+
+        \pre cabe(s)
+        \post El proceso de número de orden s tiene memoria m en el p.i.
+        \coste Logarítmico
+    */
+    void poner(long long s, int m);
+
+    /** @brief Deja de indexar un proceso
+
+        \pre cabe(s)
+        \post El proceso de número de orden s no está en el p.i.
+        \coste Logarítmico
+    */
+    void quitar(long long s);
+
+    /** @brief Vacía el índice
+
+        \pre <em>cierto</em>
+        \post El p.i. está vacío y sin árbol
+        \coste Constante
+    */
+    void vaciar();
+
+    //Consultoras
+
+    /** @brief Consulta si un número de orden tiene hoja
+
+        \pre <em>cierto</em>
+        \post El resultado indica si base <= s < base + cap
+        \coste Constante
+    */
+    bool cabe(long long s) const;
+
+    /** @brief Consulta si un proceso está indexado
+
+        \pre cabe(s)
+        \post El resultado indica si el proceso de número de orden s está en el p.i.
+        \coste Constante
+    */
+    bool contiene(long long s) const;
+
+    /** @brief Busca el primer proceso que cabe en un hueco
+
+        \pre <em>cierto</em>
+        \post El resultado es el menor número de orden >= s de un proceso del p.i.
+        de memoria <= h, -1 si no hay ninguno
+        \coste Logarítmico respecto a cap
+    */
+    long long buscar(long long s, int h) const;
+};
+#endif
@@ -0,0 +1,115 @@
+/** @file Lector.cc
+    @brief Código de la clase Lector
+*/
+
+#include "Lector.hh"
+
+thread_local Lector::Encargo* Lector::propio = nullptr;
+
+Lector::Texto::Texto(Lector& l) : l(l) {}
+
+int Lector::Texto::overflow(int c) {
+    if (c != EOF and propio != nullptr) propio->texto.push_back(c);
+    else if (c != EOF) {
+        l.pendiente.push_back(c);
+        if (l.pendiente.size() >= TRAMO) l.volcar();
+    }
+    return c;
+}
+
+streamsize Lector::Texto::xsputn(const char* s, streamsize n) {
+    if (propio != nullptr) {
+        propio->texto.append(s, n);
+        return n;
+    }
+    l.pendiente.append(s, n);
+    if (l.pendiente.size() >= TRAMO) l.volcar();
+    return n;
+}
+
+Lector::Lector() : salida(*this) {
+    acabar = false;
+    destino = cout.rdbuf(&salida);
+    hilo = thread(&Lector::escribir_elementos, this);
+}
+
+Lector::~Lector() {
+    volcar();
+    {
+        lock_guard<mutex> g(m);
+        acabar = true;
+    }
+    cv.notify_one();
+    hilo.join();
+    cout.rdbuf(destino);
+    destino->pubsync();
+}
+
+void Lector::volcar() {
+    if (pendiente.empty()) return;
+    Elemento e;
+    e.texto.swap(pendiente);
+    {
+        lock_guard<mutex> g(m);
+        cola.push_back(Elemento());
+        cola.back().texto.swap(e.texto);
+    }
+    cv.notify_one();
+}
+
+void Lector::consultar(const function<void(ostream&)>& f) {
+    volcar();                   //lo escrito antes de la consulta sale antes
+    {
+        lock_guard<mutex> g(m);
+        cola.push_back(Elemento());
+        cola.back().consulta = f;
+    }
+    cv.notify_one();
+}
+
+shared_ptr<Lector::Encargo> Lector::encargar() {
+    shared_ptr<Encargo> e = make_shared<Encargo>();
+    e->hecho = false;
+    volcar();                   //lo escrito antes del encargo sale antes
+    {
+        lock_guard<mutex> g(m);
+        cola.push_back(Elemento());
+        cola.back().encargo = e;
+    }
+    cv.notify_one();
+    return e;
+}
+
+void Lector::asignar(Encargo* e) {
+    propio = e;
+}
+
+void Lector::acabar_encargo(const shared_ptr<Encargo>& e) {
+    {
+        lock_guard<mutex> g(m);
+        e->hecho = true;
+    }
+    cv.notify_one();
+}
+
+void Lector::escribir_elementos() {
+    ostream os(destino);
+    unique_lock<mutex> l(m);
+    while (true) {
+        while ((cola.empty() and not acabar) or (not cola.empty() and cola.front().encargo and not cola.front().encargo->hecho)) {
+            cv.wait(l);         //también espera a que acabe el encargo del principio
+        }
+        if (cola.empty()) break;            //acabar y no queda nada
+        Elemento e;
+        e.texto.swap(cola.front().texto);
+        e.consulta.swap(cola.front().consulta);
+        e.encargo.swap(cola.front().encargo);
+        cola.pop_front();
+        l.unlock();
+        if (e.consulta) e.consulta(os);
+        else if (e.encargo) destino->sputn(e.encargo->texto.data(), e.encargo->texto.size());
+        else destino->sputn(e.texto.data(), e.texto.size());
+        l.lock();
+    }
+    os.flush();
+}
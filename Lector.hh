@@ -0,0 +1,174 @@
+/** @file Lector.hh
+    @brief Especificación de la clase Lector
+*/
+
+#ifndef LECTOR_HH
+#define LECTOR_HH
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#include <string>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#endif
+using namespace std;
+
+/** @class Lector
+    @brief Escritura ordenada de la salida con las consultas formateadas en un hilo aparte
+
+    Mientras existe, lo que se escribe en el canal standard de salida se acumula en
+    memoria y se pasa por tramos a una cola, en la que también se ponen las
+    consultas: funciones que escriben una copia de sólo lectura del estado tomada
+    al llegar la consulta. Un hilo lector vacía la cola en orden, escribiendo los
+    tramos tal cual y ejecutando las consultas, de modo que la salida es la misma
+    que sin lector mientras la simulación sigue con los comandos siguientes.
+
+    En la cola también se pueden reservar encargos: el sitio de la salida de un
+    comando que se ejecuta en otro hilo. Lo que escribe ese hilo en el canal
+    standard de salida mientras lo tiene asignado va al encargo, y el hilo lector
+    lo escribe en su sitio cuando el encargo ha acabado.
+*/
+class Lector {
+
+public:
+    /** @brief Salida de un comando que se ejecuta en otro hilo */
+    struct Encargo {
+        string texto;
+        bool hecho;
+    };
+
+private:
+    /** @brief Encargo en el que escribe el hilo actual (nulo: escribe en el texto pendiente) */
+    static thread_local Encargo* propio;
+
+    /** @brief Canal que guarda lo escrito en el texto pendiente del lector */
+    class Texto : public streambuf {
+    private:
+        Lector& l;
+    protected:
+        int overflow(int c);
+        streamsize xsputn(const char* s, streamsize n);
+    public:
+        explicit Texto(Lector& l);
+    };
+
+    /** @brief Elemento de la cola: un tramo de texto o, si consulta no es nula, una
+        consulta o, si encargo no es nulo, un encargo */
+    struct Elemento {
+        string texto;
+        function<void(ostream&)> consulta;
+        shared_ptr<Encargo> encargo;
+    };
+
+    /** @brief Tamaño a partir del cual el texto pendiente pasa a la cola */
+    static const size_t TRAMO = 1 << 16;
+
+    /** @brief Texto escrito por la simulación que aún no está en la cola */
+    string pendiente;
+
+    /** @brief Cola de elementos por escribir, protegida por m */
+    deque<Elemento> cola;
+
+    /** @brief Exclusión mutua sobre cola, acabar y el campo hecho de los encargos */
+    mutex m;
+
+    /** @brief Aviso al lector de que hay elementos, de que ha acabado un encargo o de que debe acabar */
+    condition_variable cv;
+
+    /** @brief Indica al lector que no habrá más elementos */
+    bool acabar;
+
+    /** @brief Canal de salida original, sólo lo usa el hilo lector */
+    streambuf* destino;
+
+    /** @brief Canal por el que escribe la simulación */
+    Texto salida;
+
+    /** @brief Hilo lector */
+    thread hilo;
+
+    /** @brief Pasa el texto pendiente a la cola
+
+        \pre <em>cierto</em>
+        \post Si había texto pendiente, está al final de la cola y pendiente es vacío
+        \coste Lineal respecto al texto pendiente en el peor caso, constante amortizado
+    */
+    void volcar();
+
+    /** @brief Bucle del hilo lector
+
+        \pre <em>cierto</em>
+        \post Se han escrito en destino todos los elementos de la cola, en orden,
+        hasta que se pide acabar y la cola está vacía
+        \coste Lineal respecto a la salida escrita
+    */
+    void escribir_elementos();
+
+    Lector(const Lector&) = delete;
+    Lector& operator=(const Lector&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El canal standard de salida escribe en el p.i. y el hilo lector escribe
+        en el canal que tenía antes
+        \coste Constante
+    */
+    Lector();
+
+    /** @brief Destructora.
+
+        \pre Todos los encargos del p.i. se acaban
+        \post Se han escrito todos los elementos y el texto pendiente y el canal
+        standard de salida vuelve a escribir en su canal original
+        \coste Lineal respecto a la salida pendiente
+    */
+    ~Lector();
+
+    //Modificadoras
+
+    /** @brief Añade una consulta
+
+        \pre f sólo usa datos propios (copias tomadas al llegar la consulta o datos
+        inmutables compartidos)
+        \post f se ejecutará en el hilo lector con el canal de salida original,
+        después de escribir todo lo escrito hasta ahora
+        \coste Constante amortizado
+    */
+    void consultar(const function<void(ostream&)>& f);
+
+    /** @brief Reserva el sitio de la salida de un comando que se ejecuta en otro hilo
+
+        \pre <em>cierto</em>
+        \post El resultado es un encargo sin acabar que el hilo lector escribirá
+        después de todo lo escrito hasta ahora y antes de lo que se escriba después
+        (consultar asignar() y acabar_encargo())
+        \coste Constante amortizado
+    */
+    shared_ptr<Encargo> encargar();
+
+    /** @brief Hace que el hilo actual escriba en un encargo
+
+        \pre e es nulo o es un encargo sin acabar de un lector que existe
+        \post Lo que escribe el hilo actual en el canal standard de salida va a e; si e
+        es nulo, vuelve a ir al texto pendiente (sólo desde el hilo de la simulación)
+        \coste Constante
+    */
+    static void asignar(Encargo* e);
+
+    /** @brief Acaba un encargo
+
+        \pre e es un encargo sin acabar del p.i. en el que ya no escribe ningún hilo
+        \post e está acabado: el hilo lector puede escribirlo
+        \coste Constante
+    */
+    void acabar_encargo(const shared_ptr<Encargo>& e);
+};
+#endif
@@ -0,0 +1,58 @@
+/** @file Lentos.cc
+    @brief Código de la clase Lentos
+*/
+
+#include "Lentos.hh"
+#include "Contadores.hh"
+#include <sstream>
+
+Lentos::Eco::Eco(Lentos& l) : l(l) {}
+
+int Lentos::Eco::underflow() {
+    int x = l.origen->sbumpc();
+    if (x == EOF) return EOF;
+    c = x;
+    if (l.texto.size() < LONGITUD) l.texto.push_back(c);
+    setg(&c, &c, &c + 1);
+    return x;
+}
+
+Lentos::Lentos(long long umbral, const string& nom) : fich(nom.c_str(), ios::app), entrada(*this) {
+    this->umbral = umbral;
+    reencolados = 0;
+    origen = cin.rdbuf(&entrada);
+}
+
+Lentos::~Lentos() {
+    cin.rdbuf(origen);
+}
+
+void Lentos::empezar() {
+    ini = chrono::steady_clock::now();
+    reencolados = Contadores::reencolados;
+}
+
+void Lentos::acabar(const Cluster& c, const Area_espera& ae) {
+    long long us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - ini).count();
+    if (us >= umbral) {
+        //el texto empieza con el salto de línea del comando anterior y puede acabar con el siguiente
+        size_t a = texto.find_first_not_of(" \t\r\n");
+        size_t b = texto.find_last_not_of(" \t\r\n");
+        string cmd = (a == string::npos) ? "" : texto.substr(a, b - a + 1);
+        for (size_t i = 0; i < cmd.size(); ++i) if (cmd[i] == '\n' or cmd[i] == '\r') cmd[i] = ' ';
+        if (texto.size() == LONGITUD) cmd += "...";
+        istringstream is(cmd);
+        string nombre, id;
+        is >> nombre >> id;
+        fich << us << " | " << cmd << " | procesadores " << c.num_procesadores();
+        int procesos, huecos;
+        if (c.resumen_prc(id, procesos, huecos)) fich << " | " << id << " procesos " << procesos << " huecos " << huecos;
+        fich << " | espera " << ae.num_procesos()
+             << " | reencolados " << Contadores::reencolados - reencolados << endl;
+    }
+    texto.clear();
+}
+
+bool Lentos::abierto() const {
+    return bool(fich);
+}
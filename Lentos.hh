@@ -0,0 +1,123 @@
+/** @file Lentos.hh
+    @brief Especificación de la clase Lentos
+*/
+
+#ifndef LENTOS_HH
+#define LENTOS_HH
+
+#include "Cluster.hh"
+#include "Area_espera.hh"
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#endif
+using namespace std;
+
+/** @class Lentos
+    @brief Registro de los comandos lentos con un resumen del estado
+
+    Mientras existe, el canal standard de entrada pasa por el p.i., que guarda el
+    texto de cada comando (acotado a LONGITUD caracteres). Los comandos que tardan
+    al menos el umbral se escriben en un fichero aparte, una línea por comando:
+    tiempo en microsegundos, texto del comando y, después de ejecutarlo, el número
+    de procesadores del cluster, los procesos y huecos del procesador de su segundo
+    argumento (si es un procesador), los procesos en el área de espera y los
+    procesos reencolados por el comando. Por debajo del umbral sólo se leen el
+    reloj y un contador.
+*/
+class Lentos {
+
+private:
+    /** @brief Canal de entrada que lee del original y guarda el texto leído */
+    class Eco : public streambuf {
+    private:
+        Lentos& l;
+        char c;                 //último carácter leído (buffer de uno)
+    protected:
+        int underflow();
+    public:
+        explicit Eco(Lentos& l);
+    };
+
+    /** @brief Caracteres guardados como mucho del texto de un comando */
+    static const size_t LONGITUD = 200;
+
+    /** @brief Tiempo mínimo en microsegundos de un comando para registrarlo */
+    long long umbral;
+
+    /** @brief Fichero del registro */
+    ofstream fich;
+
+    /** @brief Texto leído desde el final del comando anterior */
+    string texto;
+
+    /** @brief Canal de entrada original */
+    streambuf* origen;
+
+    /** @brief Canal por el que lee la simulación */
+    Eco entrada;
+
+    /** @brief Inicio del comando en curso */
+    chrono::steady_clock::time_point ini;
+
+    /** @brief Reencolados al inicio del comando en curso (consultar la clase Contadores) */
+    long long reencolados;
+
+    Lentos(const Lentos&) = delete;
+    Lentos& operator=(const Lentos&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora con umbral y fichero.
+
+        \pre umbral >= 0
+        \post El p.i. registra en el fichero nom (al final, si ya existe) los
+        comandos de al menos umbral microsegundos y el canal standard de entrada
+        lee a través del p.i.; si no se puede abrir el fichero, abierto() es falso
+        \coste Constante
+    */
+    Lentos(long long umbral, const string& nom);
+
+    /** @brief Destructora.
+
+        \pre <em>cierto</em>
+        \post El canal standard de entrada vuelve a leer de su canal original
+        \coste Constante
+    */
+    ~Lentos();
+
+    //Modificadoras
+
+    /** @brief Empieza un comando
+
+        \pre El nombre del comando ya se ha leído
+        \post Se han guardado el instante actual y los reencolados actuales
+        \coste Constante
+    */
+    void empezar();
+
+    /** @brief Acaba un comando
+
+        \pre Se ha llamado a empezar() al inicio del comando y ya se han leído sus argumentos
+        \post Si el comando ha tardado al menos el umbral, se ha escrito su línea en
+        el fichero con el estado de c y ae; el texto guardado es vacío
+        \coste Constante por debajo del umbral; si no, logarítmico (búsqueda del
+        procesador) más lineal sobre sus huecos y sobre el número de prioridades
+    */
+    void acabar(const Cluster& c, const Area_espera& ae);
+
+    //Consultoras
+
+    /** @brief Consulta si el fichero del registro está abierto
+
+        \pre <em>cierto</em>
+        \post El resultado indica si se ha podido abrir el fichero
+        \coste Constante
+    */
+    bool abierto() const;
+};
+#endif
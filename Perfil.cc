@@ -0,0 +1,126 @@
+/** @file Perfil.cc
+    @brief Código de la clase Perfil
+*/
+
+#include "Perfil.hh"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+bool Perfil::activo = false;
+int Perfil::fd[Perfil::N] = {-1, -1, -1, -1, -1};
+string Perfil::causa;
+map<string, Perfil::Acumulado> Perfil::comandos;
+map<string, Perfil::Acumulado> Perfil::operaciones;
+
+/** @brief Nombres de los contadores, en el orden de Lectura::v */
+static const char* const NOMBRES[Perfil::N] = {"ciclos", "instrucciones", "fallos_l1d", "fallos_llc", "saltos_fallidos"};
+
+/** @brief Abre un contador hardware para el hilo actual; devuelve -1 y deja errno si no se puede */
+static int abrir(unsigned int tipo, unsigned long long config) {
+    perf_event_attr pe;
+    memset(&pe, 0, sizeof(pe));
+    pe.type = tipo;
+    pe.size = sizeof(pe);
+    pe.config = config;
+    pe.exclude_kernel = 1;      //sin privilegios sólo se puede medir el espacio de usuario
+    pe.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+}
+
+void Perfil::activar(bool b) {
+    if (b == activo) return;
+    activo = b;
+    if (b) {
+        const unsigned long long l1d = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        fd[0] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        int err = errno;
+        fd[1] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fd[2] = abrir(PERF_TYPE_HW_CACHE, l1d);
+        fd[3] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fd[4] = abrir(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        causa.clear();
+        bool alguno = false;
+        for (int i = 0; i < N; ++i) if (fd[i] >= 0) alguno = true;
+        if (not alguno) causa = strerror(err);
+    }
+    else {
+        for (int i = 0; i < N; ++i) {
+            if (fd[i] >= 0) close(fd[i]);
+            fd[i] = -1;
+        }
+    }
+}
+
+bool Perfil::activado() {
+    return activo;
+}
+
+void Perfil::leer(Lectura& l) {
+    for (int i = 0; i < N; ++i) {
+        unsigned long long x;
+        if (fd[i] >= 0 and read(fd[i], &x, sizeof(x)) == sizeof(x)) l.v[i] = x;
+        else l.v[i] = -1;
+    }
+    l.ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Perfil::acumular(map<string, Acumulado>& t, const string& nombre, const Lectura& ini) {
+    Lectura fin;
+    leer(fin);
+    map<string, Acumulado>::iterator it = t.find(nombre);
+    if (it == t.end()) {
+        Acumulado a;
+        a.veces = 0;
+        a.ns = 0;
+        for (int i = 0; i < N; ++i) a.v[i] = -1;
+        it = t.insert(make_pair(nombre, a)).first;
+    }
+    Acumulado& a = it->second;
+    ++a.veces;
+    a.ns += fin.ns - ini.ns;
+    for (int i = 0; i < N; ++i) {
+        if (ini.v[i] >= 0 and fin.v[i] >= 0) a.v[i] = (a.v[i] < 0 ? 0 : a.v[i]) + fin.v[i] - ini.v[i];
+    }
+}
+
+void Perfil::acumular_comando(const string& comando, const Lectura& ini) {
+    acumular(comandos, comando, ini);
+}
+
+Perfil::Tramo::Tramo(const char* nombre) {
+    this->nombre = nombre;
+    activo = Perfil::activo;
+    if (activo) leer(ini);
+}
+
+Perfil::Tramo::~Tramo() {
+    if (activo) acumular(operaciones, nombre, ini);
+}
+
+void Perfil::escribir_tabla(ostream& os, const char* titulo, const map<string, Acumulado>& t) {
+    os << titulo << " veces us";
+    for (int i = 0; i < N; ++i) os << ' ' << NOMBRES[i];
+    os << '\n';
+    for (map<string, Acumulado>::const_iterator it = t.begin(); it != t.end(); ++it) {
+        const Acumulado& a = it->second;
+        os << it->first << ' ' << a.veces << ' ' << a.ns / 1000;
+        for (int i = 0; i < N; ++i) {
+            if (a.v[i] < 0) os << " -";
+            else os << ' ' << a.v[i];
+        }
+        os << '\n';
+    }
+}
+
+void Perfil::escribir(ostream& os) {
+    if (comandos.empty() and operaciones.empty()) return;
+    if (not causa.empty()) os << "perfil: contadores hardware no disponibles (" << causa << "), solo tiempo\n";
+    escribir_tabla(os, "comando", comandos);
+    if (not operaciones.empty()) escribir_tabla(os, "operacion", operaciones);
+    os.flush();
+}
@@ -0,0 +1,131 @@
+/** @file Perfil.hh
+    @brief Especificación de la clase Perfil
+*/
+
+#ifndef PERFIL_HH
+#define PERFIL_HH
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#include <map>
+#include <string>
+#endif
+using namespace std;
+
+/** @class Perfil
+    @brief Perfil de rendimiento por comando y por operación con los contadores hardware
+
+    Con el perfil activado se abren, para el hilo de la simulación, los contadores
+    hardware de Linux (perf_event_open) de ciclos, instrucciones, fallos de lectura
+    de la caché L1 de datos, fallos de la caché de último nivel y saltos mal
+    predichos, y se acumulan por cada comando y por cada operación instrumentada
+    (consultar la clase Tramo) junto con el tiempo real. Los contadores que el
+    sistema no ofrece (sin soporte, en una máquina virtual o sin permisos) se
+    omiten y, si no hay ninguno, sólo se mide el tiempo. Los trabajos repartidos
+    entre otros hilos sólo cuentan en el tiempo.
+*/
+class Perfil {
+
+public:
+    /** @brief Número de contadores hardware */
+    static const int N = 5;
+
+    /** @brief Valores de los contadores en un instante */
+    struct Lectura {
+        long long v[N];         //contadores hardware (-1 si no disponibles)
+        long long ns;           //tiempo real en nanosegundos
+    };
+
+    /** @class Tramo
+        @brief Medición de una operación mientras dura el objeto
+
+        Con el perfil desactivado no lee nada.
+    */
+    class Tramo {
+    private:
+        const char* nombre;
+        bool activo;
+        Lectura ini;
+    public:
+        /** @brief Empieza a medir la operación nombre (una cadena constante) */
+        explicit Tramo(const char* nombre);
+
+        /** @brief Acumula lo medido desde la creación en la entrada de la operación */
+        ~Tramo();
+    };
+
+private:
+    /** @brief Lo acumulado por un comando o una operación */
+    struct Acumulado {
+        long long veces;
+        long long v[N];
+        long long ns;
+    };
+
+    /** @brief Indica si el perfil está activado */
+    static bool activo;
+
+    /** @brief Descriptor de cada contador abierto, -1 si no está disponible */
+    static int fd[N];
+
+    /** @brief Causa por la que no hay ningún contador, vacía si hay alguno */
+    static string causa;
+
+    /** @brief Acumulado por comando */
+    static map<string, Acumulado> comandos;
+
+    /** @brief Acumulado por operación instrumentada */
+    static map<string, Acumulado> operaciones;
+
+    /** @brief Suma a la entrada de t la diferencia entre ahora e ini */
+    static void acumular(map<string, Acumulado>& t, const string& nombre, const Lectura& ini);
+
+    /** @brief Escribe una tabla de acumulados en os */
+    static void escribir_tabla(ostream& os, const char* titulo, const map<string, Acumulado>& t);
+
+public:
+    /** @brief Activa o desactiva el perfil
+
+        \pre <em>cierto</em>
+        \post Si b, el perfil está activado y los contadores disponibles abiertos; si
+        no, están cerrados. Los acumulados se conservan
+        \coste Constante (llamadas al sistema)
+    */
+    static void activar(bool b);
+
+    /** @brief Consulta si el perfil está activado
+
+        \pre <em>cierto</em>
+        \post El resultado indica si el perfil está activado
+        \coste Constante
+    */
+    static bool activado();
+
+    /** @brief Lee los contadores
+
+        \pre <em>cierto</em>
+        \post l contiene los valores actuales de los contadores y del tiempo real
+        \coste Constante (una llamada al sistema por contador abierto)
+    */
+    static void leer(Lectura& l);
+
+    /** @brief Acumula un comando
+
+        \pre ini es una lectura hecha al empezar el comando
+        \post La diferencia entre los contadores actuales e ini se ha sumado a la
+        entrada del comando, y la entrada cuenta una ejecución más
+        \coste Logarítmico respecto al número de comandos distintos
+    */
+    static void acumular_comando(const string& comando, const Lectura& ini);
+
+    /** @brief Operación de escritura del perfil
+
+        \pre <em>cierto</em>
+        \post Si se ha acumulado algo, se han escrito en os una tabla con lo acumulado
+        por cada comando y otra por cada operación instrumentada, con "-" en los
+        contadores no disponibles y, si no había ninguno, su causa
+        \coste Lineal respecto al número de entradas
+    */
+    static void escribir(ostream& os);
+};
+#endif
@@ -3,55 +3,320 @@
 */
 
 #include "Prioridad.hh"
+#include "Contadores.hh"
+#include "Perfil.hh"
 
 Prioridad::Prioridad() {
     env.first = env.second = 0;
+    modificado = true;
+    limite = 0;
+    primero = 0;
+    muertos = 0;
+    con_indice = false;
+}
+
+void Prioridad::tocar() {
+    modificado = true;
+    texto.reset();
+}
+
+void Prioridad::encolar(const Proceso& p) {
+    if (limite == 0 or (disco.vacio() and cola.empty() and ant.size() < limite)) {
+        if (con_indice and not indice.cabe(primero + ant.size())) reindexar();  //se dobla: coste amortizado constante
+        ant.push_back(p);
+        if (con_indice) indice.poner(primero + ant.size() - 1, p.consultar_MEM());
+    }
+    else {
+        cola.push_back(p);
+        if (cola.size() >= limite) {        //la parte nueva pasa a disco de una vez
+            Contadores::traslados += cola.size();
+            disco.añadir(cola);
+            cola.clear();
+        }
+    }
+}
+
+Proceso Prioridad::desencolar() {
+    Proceso p = ant.front();
+    quitar_frente();
+    rellenar();
+    return p;
+}
+
+bool Prioridad::vivo(int i) const {
+    return muertos == 0 or indice.contiene(primero + i);
+}
+
+void Prioridad::quitar_frente() {
+    if (con_indice) indice.quitar(primero);
+    ant.pop_front();
+    ++primero;
+    while (not ant.empty() and not vivo(0)) {       //el frente nunca queda muerto
+        ant.pop_front();
+        ++primero;
+        --muertos;
+    }
+}
+
+void Prioridad::reindexar() {
+    if (muertos > 0) {
+        deque<Proceso> d;
+        for (int i = 0; i < ant.size(); ++i) if (vivo(i)) d.push_back(ant[i]);
+        ant.swap(d);
+        muertos = 0;
+    }
+    if (con_indice) indice.construir(primero, ant);
+    else indice.vaciar();
+}
+
+void Prioridad::indexar(bool b) {
+    if (b == con_indice) return;
+    con_indice = b;
+    reindexar();
+}
+
+void Prioridad::rellenar() {
+    if (ant.empty() and limite > 0) {
+        if (not disco.vacio()) {
+            disco.extraer(ant, limite);
+            Contadores::traslados += ant.size();
+        }
+        else ant.swap(cola);
+    }
+}
+
+void Prioridad::limitar(int n) {
+    if (n == limite) return;
+    if (n == 0) {                   //todo vuelve a memoria y a mjob
+        while (not disco.vacio()) disco.extraer(ant, limite);
+        ant.insert(ant.end(), cola.begin(), cola.end());
+        cola.clear();
+        limite = 0;
+        filtro.vaciar();
+        mjob.cambiar_soporte(false);
+    }
+    else {
+        if (limite == 0) {          //los ids pasan a disco, con el filtro delante
+            vector<int> v;
+            mjob.consultar_ids(v);
+            for (int i = 0; i < v.size(); ++i) filtro.insertar(v[i]);
+            mjob.cambiar_soporte(true);
+        }
+        limite = n;
+        if (ant.size() > limite and disco.vacio() and cola.empty()) {      //el exceso de ant pasa a disco
+            deque<Proceso> resto(ant.begin() + limite, ant.end());
+            ant.erase(ant.begin() + limite, ant.end());
+            while (not resto.empty()) {
+                encolar(resto.front());
+                resto.pop_front();
+            }
+        }
+    }
 }
 
 void Prioridad::add_job(const Proceso& p) {
-    ant.insert(ant.end(), p);
-    mjob.insert(make_pair(p.consultar_ID(),p));
+    tocar();
+    encolar(p);
+    mjob.insertar(p.consultar_ID());
+    if (limite > 0) filtro.insertar(p.consultar_ID());
+}
+
+void Prioridad::add_jobs(const vector<Proceso>& v) {
+    for (int i = 0; i < v.size(); ++i) {    //uno a uno, en el orden de v
+        if (existe_job(v[i].consultar_ID())) cout << "error: ya existe proceso" << endl;
+        else add_job(v[i]);
+    }
 }
 
 void Prioridad::enviar_proceso(int& n, Cluster& c) {    
+    Perfil::Tramo tr("Prioridad::enviar_proceso");
     if (not ant.empty()) {      //a de haber almenos un proceso en la prioridad
-        list<Proceso>::iterator it = ant.begin();
-        int size = ant.size();      //cota del bucle
-        int i = 0;
+        if (n > 0) tocar();
+        if (muertos > 0) reindexar();       //los lotes se toman de los primeros de ant
+        long long size = num_procesos();      //cota del bucle
+        long long i = 0;
+        int k = c.consultar_especulacion();
+        vector<int> cand;           //candidatos del lote actual (los primeros procesos de ant)
+        int j = 0;
         while (n > 0 and i < size) {
-            if (c.recibir_job(*it)) {   //el proceso enviado cabe en almenos un procesador
-                ++env.first;
-                --n;
-                mjob.erase((*it).consultar_ID());   //el proceso aceptado ya no debe estar en el area de espera
-                it = ant.erase(it);
+            if (k > 0 and j == cand.size()) {       //lote nuevo: sólo procesos que aún no se han visitado
+                long long b = k;
+                if (b > ant.size()) b = ant.size();
+                if (b > size - i) b = size - i;
+                vector<Proceso> lote(ant.begin(), ant.begin() + b);
+                c.candidatos(lote, cand);
+                j = 0;
             }
-            else {                              //el proceso ha sido rechazado 
-                ant.insert(ant.end(), (*it));   //se devuelve al final de la lista (ahora es el más antiguo)
-                it = ant.erase(it);             //lo eliminamos del inicio de la lista y avanzamos al siguiente proceso a enviar 
-                ++env.second;   
+            Proceso p = desencolar();       //el proceso a enviar siempre es el del frente de la cola
+            bool cabe = (k > 0) ? c.recibir_job_especulado(p, cand[j++]) : c.recibir_job(p);
+            ++Contadores::enviados;
+            if (cabe) {     //el proceso enviado cabe en almenos un procesador
+                aceptado(p, c.consultar_tiempo());
+                --n;
             }
+            else rechazado(p);
             ++i;
         }
     }
 }
 
+void Prioridad::enviar_proceso(int& n, const vector<Cluster*>& v, int t) {
+    if (ant.empty()) return;
+    if (n > 0) tocar();
+    long long size = num_procesos();      //cota del bucle
+    for (long long i = 0; n > 0 and i < size; ++i) {
+        Proceso p = desencolar();
+        int memo = p.consultar_MEM();
+        int d = -1;             //mejor cluster según su resumen
+        for (int j = 0; j < v.size(); ++j) {
+            int h = v[j]->max_hueco();
+            if (h >= memo and (d == -1 or h < v[d]->max_hueco()
+                or (h == v[d]->max_hueco() and v[j]->memoria_libre() > v[d]->memoria_libre()))) d = j;
+        }
+        ++Contadores::enviados;
+        if (d != -1 and v[d]->recibir_job(p)) {
+            aceptado(p, t);
+            --n;
+        }
+        else rechazado(p);
+    }
+}
+
+void Prioridad::aceptado(const Proceso& p, int t) {
+    ++env.first;
+    espera.registrar(t - p.consultar_entrada());
+    mjob.borrar(p.consultar_ID());     //el proceso aceptado ya no debe estar en el area de espera
+    if (limite > 0) filtro.borrar(p.consultar_ID());
+}
+
+void Prioridad::rechazado(const Proceso& p) {
+    encolar(p);             //se devuelve al final de la cola (ahora es el más nuevo)
+    ++Contadores::reencolados;
+    ++env.second;
+}
+
+void Prioridad::despachar(int& h, Cluster& c) {
+    long long s = primero;
+    while (h > 0 and not ant.empty()) {
+        s = indice.buscar(s, h);        //el más antiguo desde s que cabe en h
+        if (s == -1) break;
+        Proceso p = ant[s - primero];
+        ++Contadores::enviados;
+        if (c.recibir_job(p)) {
+            tocar();
+            aceptado(p, c.consultar_tiempo());
+            if (s == primero) quitar_frente();
+            else {                      //se marca como muerto: el resto de la cola no se mueve
+                indice.quitar(s);
+                ++muertos;
+            }
+            if (c.max_hueco() < h) h = c.max_hueco();
+        }
+        ++s;
+    }
+    if (muertos > ant.size() / 2) reindexar();      //los muertos no superan a los vivos
+}
+
 bool Prioridad::existe_job(int id) const {
-    return (mjob.size() != 0 and mjob.find(id) != mjob.end());
-    
+    if (limite > 0 and not filtro.quiza(id)) return false;
+    return mjob.contiene(id);       //comprobación exacta, en disco si hay límite
 }
 
 bool Prioridad::en_espera() const {
-    return (mjob.size() != 0);
+    return (not ant.empty());       //si ant está vacía, disco y cola también
+}
+
+long long Prioridad::num_procesos() const {
+    return ant.size() - muertos + disco.tamaño() + cola.size();
+}
+
+void Prioridad::escribir_job(ostream& os) const {
+    for (int i = 0; i < ant.size(); ++i) if (vivo(i)) ant[i].escribir(os);
+    disco.escribir(os);
+    for (deque<Proceso>::const_iterator it = cola.begin(); it != cola.end(); ++it) (*it).escribir(os);
 }
 
 void Prioridad::escribir_job() const {
-    list<Proceso>::const_iterator it = ant.begin();
-    while (it != ant.end()) { 
-        (*it).escribir();
-        ++it;
-    }
+    escribir_job(cout);
 }
 
 void Prioridad::escribir_env_rech() const {
     cout << env.first << ' ' << env.second << endl; 
 }
+
+void Prioridad::escribir_espera() const {
+    espera.escribir();
+}
+
+bool Prioridad::con_cambios() const {
+    return modificado;
+}
+
+void Prioridad::escribir() const {
+    if (limite > 0) {           //la cola puede no caber en memoria: se escribe sin guardar el texto
+        escribir_job(cout);
+        escribir_env_rech();
+        return;
+    }
+    if (not texto) {            //se formatea una sola vez por cada estado de la prioridad
+        ostringstream os;
+        escribir_job(os);
+        os << env.first << ' ' << env.second << '\n';
+        texto = make_shared<const string>(os.str());
+    }
+    cout << *texto;
+}
+
+void Prioridad::instantanea(Instantanea& s) const {
+    s.texto = texto;
+    s.procesos.clear();
+    s.env = env;
+    if (limite > 0) {           //el disco sólo se puede leer desde el hilo de la simulación
+        ostringstream os;
+        escribir_job(os);
+        os << env.first << ' ' << env.second << '\n';
+        s.texto = make_shared<const string>(os.str());
+    }
+    else if (not texto) {        //sin límite no hay nada en disco
+        s.procesos.reserve(ant.size() - muertos + cola.size());
+        for (int i = 0; i < ant.size(); ++i) if (vivo(i)) s.procesos.push_back(ant[i]);
+        s.procesos.insert(s.procesos.end(), cola.begin(), cola.end());
+    }
+}
+
+void Prioridad::escribir(ostream& os, const Instantanea& s) {
+    if (s.texto) os << *s.texto;
+    else {
+        for (int i = 0; i < s.procesos.size(); ++i) s.procesos[i].escribir(os);
+        os << s.env.first << ' ' << s.env.second << '\n';
+    }
+}
+
+void Prioridad::escribir_cambios() {
+    escribir();
+    modificado = false;
+}
+
+int Prioridad::comprobar(const string& id_prior) const {
+  int fallos = 0;
+  auto falla = [&id_prior, &fallos](const char* que) {
+    cout << "error: invariante " << id_prior << ' ' << que << endl;
+    ++fallos;
+  };
+  if (ant.empty() and num_procesos() > 0) falla("partes");
+  if ((not con_indice and muertos > 0) or (con_indice and limite > 0)) falla("indice");
+  if (limite == 0 and (not disco.vacio() or not cola.empty() or filtro.tamaño() > 0)) falla("limite");
+  if (mjob.tamaño() != num_procesos() or (limite > 0 and filtro.tamaño() != num_procesos())) falla("ids");
+  for (int k = 0; k < 2; ++k) {
+    const deque<Proceso>& d = (k == 0) ? ant : cola;
+    for (int i = 0; i < d.size(); ++i) {
+      if (k == 0 and not vivo(i)) continue;
+      int id = d[i].consultar_ID();
+      if (not mjob.contiene(id) or (limite > 0 and not filtro.quiza(id))) {
+        falla("id");
+        break;
+      }
+    }
+  }
+  return fallos;
+}
@@ -7,9 +7,18 @@
 
 #include "Proceso.hh"
 #include "Cluster.hh"
+#include "Histograma.hh"
+#include "Segmento.hh"
+#include "Filtro_ids.hh"
+#include "Conjunto_ids.hh"
+#include "Indice_memoria.hh"
 #ifndef NO_DIAGRAM
-#include <list>
-#include <map>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <memory>
 #endif
 
 /** @class Prioridad
@@ -19,17 +28,158 @@
 class Prioridad
 {
 
+public:
+  /** @brief Copia de sólo lectura de lo que escribe escribir()
+
+    texto es el texto ya formateado si lo había (compartido e inmutable); si no,
+    procesos contiene los procesos en espera en orden y env los enviados y
+    rechazados */
+  struct Instantanea {
+    shared_ptr<const string> texto;
+    vector<Proceso> procesos;
+    pair<int, int> env;
+  };
+
 private:
-  /** @brief Lista de procesos
+  /** @brief Cola de procesos
+
+    Ordenada por orden de antigüedad de entrada de los procesos. Los procesos se
+    guardan por valor en bloques contiguos: sólo se envía desde el frente y sólo
+    se añade por el final. Con índice, despachar() no borra los procesos del medio:
+    los deja como muertos (los que no están en indice) hasta que llegan al frente o
+    se purga la cola; el primero de ant nunca está muerto */
+  deque<Proceso> ant;
+
+  /** @brief Número de orden del primero de ant (consultar Indice_memoria) */
+  long long primero;
+
+  /** @brief Número de procesos muertos de ant (0 si no hay índice) */
+  int muertos;
+
+  /** @brief Indica si se mantiene indice */
+  bool con_indice;
+
+  /** @brief Índice por memoria de los procesos vivos de ant, vacío si no con_indice */
+  Indice_memoria indice;
+
+  /** @brief Máximo de procesos de cada parte de la cola en memoria (0 = sin límite)
+
+    Con límite, la cola se reparte en tres partes consecutivas: ant (los más
+    antiguos), disco y cola (los más nuevos). Se cumple que si ant está vacía
+    también lo están disco y cola, y que si disco no está vacío se añade por cola */
+  int limite;
+
+  /** @brief Parte central de la cola de procesos, guardada en disco */
+  Segmento disco;
+
+  /** @brief Parte final de la cola de procesos, pendiente de pasar a disco */
+  deque<Proceso> cola;
+
+  /** @brief Filtro de los ids de los procesos si hay límite (vacío si no)
 
-    Ordenada por orden de antigüedad de entrada de los procesos*/
-  list<Proceso> ant;
+    Sólo descarta ids: si da un id como posible, existe_job() lo busca en mjob, que
+    entonces está en disco */
+  Filtro_ids filtro;
 
   /** @brief Numero de procesos enviados (aceptados) y (rechazados) al cluster */
   pair <int, int> env;
 
-  /** @brief Mapa de procesos ordenado crecientemente por su id */
-  map<int, Proceso> mjob;
+  /** @brief Conjunto de ids de los procesos, en una tabla plana: en memoria sin
+    límite y en un fichero temporal con límite */
+  Conjunto_ids mjob;
+
+  /** @brief Tiempos de espera de los procesos aceptados por el cluster */
+  Histograma espera;
+
+  /** @brief Indica si lo escrito por escribir() ha cambiado desde la última escritura de cambios */
+  bool modificado;
+
+  /** @brief Texto de escribir() ya formateado, nulo si ha cambiado desde que se formateó */
+  mutable shared_ptr<const string> texto;
+
+  /** @brief Marca el p.i. como modificado
+
+    \pre <em>cierto</em>
+    \post modificado es cierto y el texto formateado queda invalidado
+    \coste Constante
+  */
+  void tocar();
+
+  /** @brief Añade un proceso al final de la cola
+
+    \pre <em>cierto</em>
+    \post p es el último proceso de la cola; si hay límite y cola lo alcanza, cola pasa a disco
+    \coste Constante amortizado (más la escritura de un bloque en disco)
+  */
+  void encolar(const Proceso& p);
+
+  /** @brief Saca el proceso del frente de la cola
+
+    \pre Hay algún proceso en la cola
+    \post El resultado es el primer proceso de la cola, que deja de estar en ella;
+    si ant se vacía se rellena desde disco, o desde cola si disco está vacío
+    \coste Constante amortizado (más la lectura de un bloque de disco)
+  */
+  Proceso desencolar();
+
+  /** @brief Anota un proceso aceptado por el cluster
+
+    \pre p acaba de salir de la cola y ha sido aceptado en el instante t
+    \post Se ha contado como aceptado, se ha registrado su tiempo de espera y su id
+    ya no está en el p.i.
+    \coste Constante en promedio
+  */
+  void aceptado(const Proceso& p, int t);
+
+  /** @brief Anota un proceso rechazado por el cluster
+
+    \pre p acaba de salir de la cola y ha sido rechazado
+    \post p vuelve al final de la cola y se ha contado como rechazado
+    \coste El de encolar()
+  */
+  void rechazado(const Proceso& p);
+
+  /** @brief Consulta si un proceso de ant está vivo
+
+    \pre 0 <= i < ant.size()
+    \post El resultado indica si ant[i] es un proceso pendiente (no muerto)
+    \coste Constante
+  */
+  bool vivo(int i) const;
+
+  /** @brief Quita el primer proceso de ant
+
+    \pre ant no es vacía
+    \post ant ya no tiene su primer proceso ni los muertos que lo seguían
+    \coste Constante (más los muertos quitados) más logarítmico con índice
+  */
+  void quitar_frente();
+
+  /** @brief Purga los muertos de ant y vuelve a construir el índice
+
+    \pre <em>cierto</em>
+    \post ant no tiene muertos; si con_indice, indice indexa ant desde primero
+    \coste Lineal respecto al tamaño de ant
+  */
+  void reindexar();
+
+  /** @brief Rellena la parte antigua de la cola si se ha vaciado
+
+    \pre <em>cierto</em>
+    \post Si ant está vacía y hay límite, ant contiene el siguiente bloque de disco,
+    o los procesos de cola si disco está vacío
+    \coste Constante (más la lectura de un bloque de disco)
+  */
+  void rellenar();
+
+  /** @brief Operación de escritura de todos los procesos pendientes en un canal
+
+    \pre <em>cierto</em>
+    \post Se han escrito todos los procesos pendientes por orden decreciente
+    de antigüedad en el canal os
+    \coste Lineal respecto al número de procesos pendientes
+  */
+  void escribir_job(ostream& os) const;
 
 public:
   // Constructoras
@@ -50,27 +200,92 @@ public:
 
     \pre <em>cierto</em>
     \post El resultado es el p.i. más un proceso p
-    \coste Logarítmico
+    \coste Constante en promedio
 */
   void add_job(const Proceso &p);
 
+  /** @brief Añade un bloque de procesos a la prioridad
+
+    \pre <em>cierto</em>
+    \post El resultado es el p.i. más los procesos de v cuyo id no existía en el p.i.
+    ni aparece antes en v, añadidos en el orden de v. Por cada proceso
+    descartado se ha escrito un mensaje de error en el orden de v
+    \coste Lineal respecto al tamaño de v (constante en promedio por id)
+*/
+  void add_jobs(const vector<Proceso>& v);
+
+  /** @brief Fija el máximo de procesos en memoria de la prioridad
+
+    \pre n >= 0; si n > 0, el p.i. no tiene índice (consultar indexar())
+    \post Si n > 0, como mucho n procesos de la parte antigua y n de la parte nueva
+    de la cola se guardan en memoria y el resto en disco, y los ids se guardan en
+    disco con un filtro de tamaño fijo en memoria delante. Así la memoria residente
+    de la prioridad entre operaciones queda acotada sea cual sea el número de
+    procesos pendientes: 2n procesos en las colas (16 bytes cada uno más los bloques
+    de las deque), los 32 KiB del filtro, las páginas de mjob que han tocado sus
+    últimas 256 operaciones (1 MiB como mucho si cada una toca una) y el histograma
+    de esperas, que es de tamaño constante. Si n = 0 toda la cola y los ids vuelven
+    a memoria.
+    Los procesos pendientes y su orden no cambian
+    \coste Lineal respecto al número de procesos pendientes
+*/
+  void limitar(int n);
+
   // Consultoras
 
   /** @brief Intenta enviar una cantidad de procesos de el área de espera al cluster
 
      \pre n > 0
      \post El p.i. ha intentado enviar n procesos al cluster c, los procesos
-     aceptados son borrados de la prioridad, y los rechazados vuelven a la lista
-     de la prioridad como nuevos (reinicio de antigüedad)
+     aceptados son borrados de la prioridad y su tiempo de espera queda registrado,
+     y los rechazados vuelven al final de la cola de la prioridad como nuevos (reinicio de antigüedad).
+     Si c tiene activada la especulación, los procesos se colocan por lotes cuyo
+     procesador se calcula por adelantado (consultar candidatos() de la clase Cluster),
+     con el mismo resultado
      \coste Lineal sobre lineal (consultar recibir_job() de la clase cluster)
 */
   void enviar_proceso(int& n, Cluster& c);
 
+  /** @brief Intenta enviar una cantidad de procesos a un conjunto de clusters
+
+     \pre n > 0, t es el instante actual del área de espera
+     \post Como enviar_proceso(n, c), pero cada proceso se ofrece sólo al cluster de
+     v en el que mejor cabe según su resumen: el de menor mayor hueco que no es
+     menor que su memoria, en caso de empate el de más memoria libre y luego el
+     primero de v; si no cabe en ninguno se rechaza. Los tiempos de espera se miden
+     con t
+     \coste Lineal sobre el tamaño de v más el coste de recibir_job() de la clase Cluster
+  */
+  void enviar_proceso(int& n, const vector<Cluster*>& v, int t);
+
+  /** @brief Intenta colocar en el cluster los procesos que caben en un hueco liberado
+
+     \pre h >= 0, el p.i. tiene índice (consultar indexar()) y no tiene límite
+     \post Se ha intentado enviar al cluster c, por orden de antigüedad, cada proceso
+     de la prioridad cuya memoria no supera h ni el mayor hueco de c; los aceptados
+     se han borrado de la prioridad, con su tiempo de espera registrado, y los demás
+     conservan su posición y no cuentan como rechazados. h pasa a ser el mínimo
+     entre h y el mayor hueco de c tras los envíos
+     \coste Logarítmico (índice por memoria) por cada proceso que cabe, sin visitar
+     los que no caben, más el coste de recibir_job() de la clase Cluster por cada uno
+  */
+  void despachar(int& h, Cluster& c);
+
+  /** @brief Activa o desactiva el índice por memoria de la cola
+
+    \pre <em>cierto</em>
+    \post Si b, el p.i. mantiene el índice que usa despachar(); si no, no lo
+    mantiene y su cola no tiene muertos
+    \coste Lineal respecto al tamaño de la parte antigua de la cola si cambia,
+    constante si no
+  */
+  void indexar(bool b);
+
   /** @brief Consultora de la existencia de un proceso con una prioridad
 
     \pre El parámetro implícito está inicializado
     \post El resultado indica si el proceso con ID = id existe en el p.i.
-    \coste Logarítmico
+    \coste Constante en promedio (con límite, sin leer el disco si el filtro descarta id)
 */
   bool existe_job(int id) const;
 
@@ -82,6 +297,37 @@ public:
   */
   bool en_espera() const;
 
+  /** @brief Consultora del número de procesos pendientes
+
+    \pre <em>cierto</em>
+    \post El resultado es el número de procesos pendientes de la prioridad, en
+    memoria o en disco
+    \coste Constante
+  */
+  long long num_procesos() const;
+
+  /** @brief Comprueba los invariantes de la prioridad
+
+    \pre id_prior es el id del p.i.
+    \post Por cada invariante que no se cumple (partes de la cola consecutivas, sin
+    partes en disco sin límite, y el conjunto de ids con exactamente un id por
+    proceso pendiente en memoria o en disco) se ha escrito una línea
+    "error: invariante <id_prior> <qué>"; el resultado es cuántas
+    \coste Lineal respecto a los procesos pendientes en memoria (constante en
+    promedio por id)
+  */
+  int comprobar(const string& id_prior) const;
+
+  /** @brief Consultora de cambios pendientes de escribir
+
+    \pre <em>cierto</em>
+    \post El resultado indica si los procesos pendientes o el número de enviados
+    y rechazados han cambiado desde la última llamada a escribir_cambios(), o
+    desde su creación
+    \coste Constante
+  */
+  bool con_cambios() const;
+
   // Lectura y escritura
 
   /** @brief Operación de escritura de todos los procesos pendientes
@@ -89,7 +335,7 @@ public:
     \pre Existe almenos un proceso pendiente
     \post Se ha escrito todos los procesos pendientes por orden decreciente
           de antigüedad en el canal standard de salida.
-    \coste Lineal (bucle para todos los elementos de la lista)
+    \coste Lineal (bucle para todos los elementos de la cola)
   */
   void escribir_job() const;
 
@@ -102,5 +348,51 @@ public:
      \coste Constante
   */
   void escribir_env_rech() const;
+
+  /** @brief Operación de escritura de la prioridad
+
+    \pre <em>cierto</em>
+    \post Se han escrito los procesos pendientes (si los hay) como escribir_job()
+    seguidos de los enviados y rechazados como escribir_env_rech()
+    \coste Lineal la primera vez tras un cambio (se guarda el texto formateado),
+    constante más el tamaño del texto en las siguientes; con límite no se guarda
+    el texto y siempre es lineal
+  */
+  void escribir() const;
+
+  /** @brief Toma una copia de sólo lectura de la prioridad
+
+    \pre <em>cierto</em>
+    \post s permite escribir lo mismo que escribir() en el estado actual del p.i.
+    \coste Constante si el texto ya está formateado; si no, lineal (copia de los
+    procesos, o formateo del texto si hay límite, porque parte de la cola está en disco)
+  */
+  void instantanea(Instantanea& s) const;
+
+  /** @brief Operación de escritura de una copia de una prioridad
+
+    \pre s es una copia tomada con instantanea()
+    \post Se ha escrito en os lo que escribía escribir() al tomar s
+    \coste Lineal respecto al tamaño del texto
+  */
+  static void escribir(ostream& os, const Instantanea& s);
+
+  /** @brief Operación de escritura de los cambios
+
+    \pre <em>cierto</em>
+    \post Se ha hecho escribir() y el p.i. deja de tener cambios pendientes
+    \coste El de escribir()
+  */
+  void escribir_cambios();
+
+  /** @brief Operación de escritura de las estadísticas de espera
+
+     \pre <em>cierto</em>
+     \post Se ha escrito el número de procesos aceptados con espera registrada y
+     los percentiles 50 y 99 y el máximo de su tiempo de espera en el canal
+     standard de salida.
+     \coste Constante
+  */
+  void escribir_espera() const;
 };
 #endif
\ No newline at end of file
@@ -3,98 +3,295 @@
 */
 
 #include "Procesador.hh"
+#include "Contadores.hh"
+#include "Perfil.hh"
+#include <algorithm>
 
 Procesador::Procesador() {
-    
+    modificado = true;
+    ocupada = 0;
+    fin = INT_MAX;
+    reg = nullptr;
+    nreg = -1;
 }
 
 Procesador::Procesador(const string& s, int m) {
+    modificado = true;
     id = s;
     free_max.second = m;
     free_max.first = 0;
-    mmem[free_max.second].insert(0);
+    ocupada = 0;                //sin procesos no se guarda el hueco: se materializa con el primero
+    fin = INT_MAX;
+    reg = nullptr;
+    nreg = -1;
 }
 
-void Procesador::eliminar_job(int id, map <int,Proceso>::iterator& it) {
-    bool borrar = true;         
-    if (id != -1) {
-        map<int,int>::iterator it1 = mjob.find(id);
-        if (it1 == mjob.end()) {
-            cout << "error: no existe proceso" << endl;
-            borrar = false;             //no hay proceso que borrar
-        }
+void Procesador::fijar_registro(Registro* r) {
+    reg = r;
+    nreg = (r == nullptr) ? -1 : r->procesador(id);
+}
+
+void Procesador::tocar() {
+    modificado = true;
+    texto.reset();
+}
+
+void Procesador::materializar() {
+    if (indices.empty() and mmem.empty()) mmem[free_max.second].insert(0);
+}
+
+int Procesador::posicion(int ind) const {
+    return lower_bound(indices.begin(), indices.end(), ind) - indices.begin();
+}
+
+int Procesador::buscar_id(int id) const {
+    //con punteros y no iteradores: bfs la llama desde varios hilos (consultar prc de la clase Cluster)
+    const pair<int, int>* ini = por_id.data();
+    const pair<int, int>* fin = ini + por_id.size();
+    const pair<int, int>* it = lower_bound(ini, fin, make_pair(id, INT_MIN));
+    if (it == fin or it->first != id) return -1;
+    return it - ini;
+}
+
+void Procesador::mover_id(int id, int ind) {
+    por_id[buscar_id(id)].second = ind;
+}
+
+void Procesador::quitar_ids(vector<int>& q) {
+    if (q.size() == 1) {
+        int k = buscar_id(q[0]);
+        Contadores::traslados += por_id.size() - k - 1;
+        por_id.erase(por_id.begin() + k);
+        return;
+    }
+    sort(q.begin(), q.end());
+    int e = 0, j = 0;           //e = siguiente posición a escribir, j = siguiente de q
+    for (int k = 0; k < por_id.size(); ++k) {
+        if (j < q.size() and por_id[k].first == q[j]) ++j;
         else {
-            it = mpos.find(it1->second);        //iterador que apunta al proceso a eliminar del map de indices
-            free_max.first -= it->second.consultar_MEM();   //libera la memoria ocupada
+            if (e != k) {
+                ++Contadores::traslados;
+                por_id[e] = por_id[k];
+            }
+            ++e;
         }
     }
-    if (borrar) {
-        mjob.erase(it->second.consultar_ID());
-        if (mjob.empty()) {     //solo habia 1 proceso
+    por_id.resize(e);
+}
+
+void Procesador::eliminar_job(int id) {
+    int k = buscar_id(id);
+    if (k == -1) cout << "error: no existe proceso" << endl;
+    else {
+        int ind = por_id[k].second;
+        int s = posicion(ind);          //posición del proceso en las columnas
+        int n = indices.size();
+        free_max.first -= mems[s];      //libera la memoria ocupada
+        tocar();
+        ++Contadores::eliminados;
+        if (reg != nullptr) reg->anotar(Registro::ELIMINA, reg->tiempo(), nreg, id);
+        ocupada -= mems[s];
+        if (n == 1) {           //solo habia 1 proceso: el procesador vuelve a estar inactivo
             mmem.clear();
-            mmem[free_max.second].insert(0);
-        }
-        else {                  //habia mas de 1 proceso
-            int ind = it->first;  
-            int mem = it->second.consultar_MEM() + ind;
-            int ind_ant, ind_sig;
-            if (it != mpos.begin()) {       //el proceso NO esta al inicio de la memoria
-                --it;
-                ind_ant = it->first + it->second.consultar_MEM();   
-                if (ind != ind_ant) {
-                    mmem[ind - ind_ant].erase(ind_ant);         
-                    if (mmem[ind - ind_ant].empty()) mmem.erase(ind - ind_ant);
-                }
-                ++it;
-            }
-            else {                          //el proceso esta al inicio de la memoria
-                ind_ant = 0;
-                if (ind != 0) {
-                    mmem[ind].erase(0);
-                    if (mmem[ind].empty()) mmem.erase(ind);   
-                }
-            }
-            ++it;   
-            if (it != mpos.end()) {         //el proceso a eliminar NO es el último de la memoria
-                ind_sig = it->first;
-                if (ind_sig != mem) {
-                    mmem[ind_sig - mem].erase(mem);
-                    if (mmem[ind_sig - mem].empty()) mmem.erase(ind_sig - mem);
-                }
-            }
-            else {                          //el proceso a eliminar es el último de la memoria
-                ind_sig = free_max.second;
-                if (mem != free_max.second){
-                    mmem[free_max.second - mem].erase(mem);
-                    if (mmem[free_max.second - mem].empty()) mmem.erase(free_max.second - mem);
-                }
-            }        
-            --it;
+            fin = INT_MAX;
+        }
+        else {                  //habia mas de 1 proceso: los huecos de los lados y el del proceso se fusionan
+            int mem = ind + mems[s];
+            int ind_ant = (s > 0) ? indices[s - 1] + mems[s - 1] : 0;
+            int ind_sig = (s + 1 < n) ? indices[s + 1] : free_max.second;
+            if (ind != ind_ant) quitar_hueco(ind_ant, ind - ind_ant);
+            if (ind_sig != mem) quitar_hueco(mem, ind_sig - mem);
+            ++Contadores::huecos;
             mmem[ind_sig - ind_ant].insert(ind_ant);
+        }
+        Contadores::traslados += n - s - 1;     //los procesos de índice mayor se desplazan
+        indices.erase(indices.begin() + s);
+        ids.erase(ids.begin() + s);
+        mems.erase(mems.begin() + s);
+        tiempos.erase(tiempos.begin() + s);
+        Contadores::traslados += por_id.size() - k - 1;
+        por_id.erase(por_id.begin() + k);
+    }
+}
 
+void Procesador::quitar_hueco(int ind, int tam) {
+    ++Contadores::huecos;
+    map<int, set<int> >::iterator it = mmem.find(tam);
+    it->second.erase(ind);
+    if (it->second.empty()) mmem.erase(it);
+}
+
+void Procesador::liberar(int t, const vector<int>& borrar) {
+    int n = indices.size();
+    int s = borrar[0];          //sólo se recorre la zona afectada
+    int ini = (s > 0) ? indices[s - 1] + mems[s - 1] : 0;    //final del último proceso superviviente
+    int cursor = ini;           //final del proceso anterior (superviviente o no)
+    bool sucio = false;         //se ha liberado algún proceso desde el último superviviente
+    vector<pair<int, int> > huecos;     //huecos (indice, tamaño) desde el último superviviente
+    vector<int> quitados;       //ids de los procesos liberados
+    int e = s;                  //siguiente posición de las columnas para un superviviente
+    int j = 0;                  //siguiente posición de borrar
+    tocar();
+    while (s < n and (sucio or j < borrar.size())) {
+        int ind = indices[s];
+        int mem = mems[s];
+        ++Contadores::liberados;
+        if (ind > cursor) huecos.push_back(make_pair(cursor, ind - cursor));
+        cursor = ind + mem;
+        if (j < borrar.size() and borrar[j] == s) {
+            ++j;
+            if (t == 0) free_max.first -= mem;    //igual que eliminar_job(), las finalizaciones no descuentan memoria ocupada
+            if (reg != nullptr) {       //una finalización ocurre justo cuando se agota su tiempo
+                if (t == 0) reg->anotar(Registro::ELIMINA, reg->tiempo(), nreg, ids[s]);
+                else reg->anotar(Registro::ACABA, reg->tiempo() + tiempos[s] + t, nreg, ids[s]);
+            }
+            ocupada -= mem;
+            quitados.push_back(ids[s]);
+            sucio = true;
         }
-        it = mpos.erase(it);
+        else {
+            if (sucio) {        //la zona entre supervivientes pasa a ser un único hueco
+                for (int i = 0; i < huecos.size(); ++i) quitar_hueco(huecos[i].first, huecos[i].second);
+                ++Contadores::huecos;
+                mmem[ind - ini].insert(ini);
+                sucio = false;
+            }
+            huecos.clear();
+            ini = cursor;
+            indices[e] = ind;
+            ids[e] = ids[s];
+            mems[e] = mem;
+            tiempos[e] = tiempos[s];
+            ++e;
+        }
+        ++s;
+    }
+    if (sucio) {                //la última zona llega hasta el final de la memoria
+        if (cursor < free_max.second) huecos.push_back(make_pair(cursor, free_max.second - cursor));
+        for (int i = 0; i < huecos.size(); ++i) quitar_hueco(huecos[i].first, huecos[i].second);
+        ++Contadores::huecos;
+        mmem[free_max.second - ini].insert(ini);
+    }
+    for (; s < n; ++s) {        //los de después de la zona se desplazan una sola vez
+        ++Contadores::traslados;
+        indices[e] = indices[s];
+        ids[e] = ids[s];
+        mems[e] = mems[s];
+        tiempos[e] = tiempos[s];
+        ++e;
+    }
+    indices.resize(e);
+    ids.resize(e);
+    mems.resize(e);
+    tiempos.resize(e);
+    quitar_ids(quitados);
+    if (indices.empty()) {      //sin procesos el procesador vuelve a estar inactivo
+        mmem.clear();
+        fin = INT_MAX;
     }
 }
 
 void Procesador::avanzar_tiempo(int t) {
-    if (not mjob.empty()) {
-        map <int, Proceso>::iterator it = mpos.begin();
-        while (it != mpos.end()) {
-            if (it->second.consultar_tiempo() <= t) eliminar_job(-1, it);  
-            else {
-                it->second.restar_tiempo(t);         
-                ++it;
-            }
+    if (indices.empty()) return;
+    if (t > 0) tocar();
+    int n = tiempos.size();
+    int* tp = tiempos.data();
+    int menor = INT_MAX;        //menor tiempo restante de los supervivientes
+    bool acaba = false;
+    for (int s = 0; s < n; ++s) {       //columna contigua, sin saltos entre nodos
+        ++Contadores::liberados;
+        tp[s] -= t;
+        if (tp[s] <= 0) acaba = true;
+        else if (tp[s] < menor) menor = tp[s];
+    }
+    fin = menor;
+    if (acaba) {
+        vector<int> borrar;     //posiciones de los que acaban, crecientes
+        for (int s = 0; s < n; ++s) {
+            if (tp[s] <= 0) borrar.push_back(s);
+        }
+        liberar(t, borrar);
+    }
+}
+
+void Procesador::eliminar_jobs(const vector<int>& ids) {
+    vector<int> borrar;
+    for (int i = 0; i < ids.size(); ++i) {
+        int k = buscar_id(ids[i]);
+        if (k == -1) cout << "error: no existe proceso" << endl;
+        else borrar.push_back(posicion(por_id[k].second));
+    }
+    if (borrar.empty()) return;
+    sort(borrar.begin(), borrar.end());
+    int e = 1;                  //un id repetido sólo se elimina una vez
+    for (int i = 1; i < borrar.size(); ++i) {
+        if (borrar[i] == borrar[e - 1]) cout << "error: no existe proceso" << endl;
+        else borrar[e++] = borrar[i];
+    }
+    borrar.resize(e);
+    liberar(0, borrar);
+}
+
+int Procesador::max_hueco() const {
+    if (indices.empty()) return free_max.second;       //inactivo: toda la memoria es un hueco
+    if (mmem.empty()) return 0;
+    return mmem.rbegin()->first;
+}
+
+void Procesador::menores_huecos(vector<int>& v) const {
+    for (int c = 0; c < v.size(); ++c) {
+        int tam = 1 << c;
+        if (indices.empty()) v[c] = (free_max.second >= tam) ? free_max.second : INT_MAX;   //inactivo: un solo hueco
+        else {
+            ++Contadores::huecos;
+            map<int, set<int> >::const_iterator it = mmem.lower_bound(tam);
+            v[c] = (it == mmem.end()) ? INT_MAX : it->first;
         }
-    }   
+    }
+}
+
+int Procesador::MEM_max() const {
+    return free_max.second;
+}
+
+void Procesador::consultar_procesos(vector<Proceso>& v) const {
+    v.clear();
+    for (int s = 0; s < indices.size(); ++s) v.push_back(Proceso(ids[s], mems[s], tiempos[s]));
+}
+
+void Procesador::consultar_huecos(vector<int>& v) const {
+    v.clear();
+    if (indices.empty()) {
+        if (free_max.second > 0) v.push_back(free_max.second);
+        return;
+    }
+    for (map<int, set<int> >::const_iterator it = mmem.begin(); it != mmem.end(); ++it) {
+        if (it->first > 0) v.insert(v.end(), it->second.size(), it->first);
+    }
+}
+
+int Procesador::MEM_ocupada() const {
+    return ocupada;
+}
+
+int Procesador::proximo_fin() const {
+    return fin;
+}
+
+int Procesador::num_procesos() const {
+    return indices.size();
 }
 
 int Procesador::MEM_libre() const {
     return free_max.second - free_max.first;
 }
 
-bool Procesador::hueco(int mem, int& hueco) {
+bool Procesador::hueco(int mem, int& hueco) const {
+    if (indices.empty()) {
+        if (mem > free_max.second) return false;
+        hueco = free_max.second;
+        return true;
+    }
     map<int,set<int> >::const_iterator it = mmem.lower_bound(mem);
     if (it == mmem.end()) return false;
     hueco = it->first;
@@ -102,61 +299,278 @@ bool Procesador::hueco(int mem, int& hueco) {
 }
 
 void Procesador::add_job(const Proceso& p) {
+    materializar();
     int memo = p.consultar_MEM();
+    ++Contadores::huecos;
     map <int,set<int>>::iterator it1 = mmem.lower_bound(memo);  //hueco igual o mayor a la memoria del proceso
     if (it1 == mmem.end()) cout << "error: no cabe proceso" << endl; 
     else {
+        tocar();
+        ++Contadores::colocados;
         free_max.first += memo;                             //actualiza memoria ocupada del procesador
+        ocupada += memo;
         set<int>::const_iterator it2 = it1->second.begin(); //indice más pequeño con hueco más ajustado 
         int hueco = it1->first - memo;                      //hueco = hueco anterior - memoria del proceso p.e: h.an. = 4, m = 2 -> hueco = 2
-        if (hueco > 0) mmem[hueco].insert(*it2 + memo);     
-        mpos.insert(make_pair(*it2, p));
-        mjob.insert(make_pair(p.consultar_ID(), *it2));
+        if (hueco > 0) {
+            ++Contadores::huecos;
+            mmem[hueco].insert(*it2 + memo);
+        }
+        int s = posicion(*it2);         //los procesos de índice mayor se desplazan
+        Contadores::traslados += indices.size() - s;
+        indices.insert(indices.begin() + s, *it2);
+        ids.insert(ids.begin() + s, p.consultar_ID());
+        mems.insert(mems.begin() + s, memo);
+        tiempos.insert(tiempos.begin() + s, p.consultar_tiempo());
+        vector<pair<int, int> >::iterator k = lower_bound(por_id.begin(), por_id.end(), make_pair(p.consultar_ID(), INT_MIN));
+        Contadores::traslados += por_id.end() - k;
+        por_id.insert(k, make_pair(p.consultar_ID(), *it2));
+        if (p.consultar_tiempo() < fin) fin = p.consultar_tiempo();
+        if (reg != nullptr) reg->anotar(Registro::COLOCA, reg->tiempo(), nreg, p.consultar_ID(), *it2);
 
         //Actualizar mapa de memoria
+        ++Contadores::huecos;
         it1->second.erase(*it2);
         if (it1->second.empty()) it1 = mmem.erase(it1);   
     }
+    if (indices.empty()) mmem.clear();  //no ha cabido en un procesador inactivo
 }
 
+void Procesador::add_jobs(const vector<Proceso>& v) {
+    int n = v.size();
+    vector<pair<int, int> > ord(n);         //(id, posición en v)
+    for (int i = 0; i < n; ++i) ord[i] = make_pair(v[i].consultar_ID(), i);
+    sort(ord.begin(), ord.end());
+
+    //una sola pasada ordenada sobre por_id: existe[i] = el id ya estaba en el procesador,
+    //rep[i] = el id aparece antes en el bloque (depende de si el anterior cupo)
+    vector<bool> existe(n, false), rep(n, false);
+    vector<pair<int, int> >::const_iterator it = por_id.begin();
+    for (int i = 0; i < n; ++i) {
+        ++Contadores::colocados;
+        while (it != por_id.end() and it->first < ord[i].first) {
+            ++Contadores::colocados;
+            ++it;
+        }
+        if (it != por_id.end() and it->first == ord[i].first) existe[ord[i].second] = true;
+        else if (i > 0 and ord[i - 1].first == ord[i].first) rep[ord[i].second] = true;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (existe[i] or (rep[i] and existe_job(v[i].consultar_ID()))) cout << "error: ya existe proceso" << endl;
+        else add_job(v[i]);
+    }
+}
 
 void Procesador::compactar_mem() {  
-    if (not mjob.empty()) {
+    Perfil::Tramo tr("Procesador::compactar_mem");
+    if (not indices.empty()) {
         mmem.clear();
-        map <int, Proceso>::iterator it = mpos.begin();     //it del map <indice,proceso>
-        int length = 0;                                    //acumula el tamaño de los procesos
-        while (it != mpos.end()) {
-            if (it->first != length) {
-                mpos.insert(it, make_pair(length, it->second)); //insert detras del elemento a eliminar
-                mjob[it->second.consultar_ID()] = length;      //actualizamos mjob map
-                length += it->second.consultar_MEM();         //siguiente indice al que se tiene que mover (tamaño total de todos los procesos anteriores)
-                it = mpos.erase(it);                         //avanzas al siguiente 
-            }
-            else {
-                length += it->second.consultar_MEM();
-                ++it;
+        int n = ids.size();
+        int length = 0;                     //acumula el tamaño de los procesos
+        for (int s = 0; s < n; ++s) {       //las columnas ya están en orden de índice
+            ++Contadores::compactados;
+            if (indices[s] != length) {
+                tocar();
+                if (reg != nullptr) reg->anotar(Registro::MUEVE, reg->tiempo(), nreg, ids[s], indices[s], length);
+                mover_id(ids[s], length);
+                indices[s] = length;
             }
+            length += mems[s];              //siguiente indice al que se tiene que mover (tamaño total de todos los procesos anteriores)
         }
+        ++Contadores::huecos;
         mmem[free_max.second - length].insert(length);      //actualizamos map de huecos con un solo hueco 
     }
 }
 
+bool Procesador::tramo_parcial(int mem, int& a, int& b, int& movido) const {
+    //g[i] = hueco delante del proceso i (g[k] = hueco final), m[i] = memoria del proceso i
+    int k = indices.size();
+    vector<int> g(k + 1);
+    const int* m = mems.data();
+    int fin = 0;
+    for (int i = 0; i < k; ++i) {
+        ++Contadores::compactados;
+        g[i] = indices[i] - fin;
+        fin = indices[i] + m[i];
+    }
+    g[k] = free_max.second - fin;
+
+    //tramo de procesos [ini, j): libera g[ini..j] y desplaza m[ini..j-1]
+    int mejor = -1, mejor_ini = 0, mejor_j = 0;
+    int libre = g[0], desplazado = 0, j = 0;
+    for (int ini = 0; ini <= k; ++ini) {
+        ++Contadores::compactados;
+        if (j < ini) {          //tramo vacío: sólo el hueco g[ini]
+            j = ini;
+            libre = g[ini];
+            desplazado = 0;
+        }
+        while (libre < mem and j < k) {
+            ++Contadores::compactados;
+            desplazado += m[j];
+            ++j;
+            libre += g[j];
+        }
+        if (libre < mem) break;     //ampliar por la derecha ya no es posible
+        if (mejor == -1 or desplazado < mejor) {
+            mejor = desplazado;
+            mejor_ini = ini;
+            mejor_j = j;
+        }
+        libre -= g[ini];        //el tramo siguiente empieza en ini + 1
+        if (ini < j) desplazado -= m[ini];
+    }
+    if (mejor == -1) return false;
+    movido = mejor;
+    a = mejor_ini;
+    b = mejor_j;
+    return true;
+}
+
+int Procesador::compactar_parcial(int mem, int& procesos) {
+    Perfil::Tramo tr("Procesador::compactar_parcial");
+    int a, b;
+    int movido;
+    if (not tramo_parcial(mem, a, b, movido)) return -1;
+    procesos = 0;
+    materializar();
+    int ini = (a > 0) ? indices[a - 1] + mems[a - 1] : 0;             //final del proceso anterior al tramo
+    int fin = (b == indices.size()) ? free_max.second : indices[b];   //inicio del proceso posterior al tramo
+    int cursor = ini;       //los huecos del tramo desaparecen: se fusionan en uno solo
+    for (int s = a; s < b; ++s) {
+        ++Contadores::compactados;
+        if (indices[s] > cursor) quitar_hueco(cursor, indices[s] - cursor);
+        cursor = indices[s] + mems[s];
+    }
+    if (fin > cursor) quitar_hueco(cursor, fin - cursor);
+    int length = ini;
+    for (int s = a; s < b; ++s) {
+        ++Contadores::compactados;
+        if (indices[s] != length) {
+            tocar();
+            if (reg != nullptr) reg->anotar(Registro::MUEVE, reg->tiempo(), nreg, ids[s], indices[s], length);
+            mover_id(ids[s], length);
+            indices[s] = length;
+            ++procesos;
+        }
+        length += mems[s];
+    }
+    ++Contadores::huecos;
+    mmem[fin - length].insert(length);
+    return movido;
+}
+
+int Procesador::coste_parcial(int mem) {
+    int a, b;
+    int movido;
+    if (not tramo_parcial(mem, a, b, movido)) return -1;
+    return movido;
+}
+
+int Procesador::coste_compactar(int& procesos) const {
+    int length = 0, movido = 0;
+    procesos = 0;
+    for (int s = 0; s < indices.size(); ++s) {
+        ++Contadores::compactados;
+        if (indices[s] != length) {
+            movido += mems[s];
+            ++procesos;
+        }
+        length += mems[s];
+    }
+    return movido;
+}
+
 string Procesador::consultar_ID() const {
     return id;
 }
 
 bool Procesador::existe_job(int id) const {
-    return (mjob.find(id) != mjob.end());
+    return buscar_id(id) != -1;
 }
 
 bool Procesador::en_curso() const {
-    return not mjob.empty();
+    return not indices.empty();
+}
+
+bool Procesador::con_cambios() const {
+    return modificado;
 }
 
 void Procesador::escribir() const {
-    map <int, Proceso>::const_iterator it;
-    for (it = mpos.begin(); it != mpos.end(); ++it) {
-        cout << it->first << ' ';       //escribe el indice
-        it->second.escribir();          //escribe atributos del proceso
+    if (not texto) {            //se formatea una sola vez por cada estado del procesador
+        ostringstream os;
+        for (int s = 0; s < indices.size(); ++s) {
+            os << indices[s] << ' ' << ids[s] << ' ' << mems[s] << ' ' << tiempos[s] << '\n';     //mismo formato que escribir() de Proceso
+        }
+        texto = make_shared<const string>(os.str());
+    }
+    cout << *texto;
+}
+
+void Procesador::instantanea(Instantanea& s) const {
+    s.texto = texto;
+    s.procesos.clear();
+    if (not texto) {
+        s.procesos.reserve(indices.size());
+        for (int i = 0; i < indices.size(); ++i) s.procesos.push_back(make_pair(indices[i], Proceso(ids[i], mems[i], tiempos[i])));
     }
-}
\ No newline at end of file
+}
+
+void Procesador::escribir(ostream& os, const Instantanea& s) {
+    if (s.texto) os << *s.texto;
+    else {
+        for (int i = 0; i < s.procesos.size(); ++i) {
+            os << s.procesos[i].first << ' ';
+            s.procesos[i].second.escribir(os);
+        }
+    }
+}
+
+void Procesador::escribir_cambios() {
+    escribir();
+    modificado = false;
+}
+
+int Procesador::comprobar() const {
+    int fallos = 0;
+    auto falla = [this, &fallos](const char* que) {
+        cout << "error: invariante " << id << ' ' << que << endl;
+        ++fallos;
+    };
+    int n = ids.size();
+    if (mems.size() != n or tiempos.size() != n or indices.size() != n or por_id.size() != n) {
+        falla("columnas");
+        return fallos;
+    }
+    for (int k = 1; k < n; ++k) {
+        if (por_id[k - 1].first >= por_id[k].first) falla("orden por_id");
+    }
+    set<pair<int, int> > esperados;     //(tamaño, índice) de cada hueco entre procesos
+    int cursor = 0;
+    long long suma = 0;
+    int menor = INT_MAX;
+    for (int s = 0; s < n; ++s) {
+        if (mems[s] <= 0 or tiempos[s] <= 0) falla("proceso");
+        if (indices[s] < cursor) falla("solapamiento");
+        else if (indices[s] > cursor) esperados.insert(make_pair(indices[s] - cursor, cursor));
+        cursor = indices[s] + mems[s];
+        int k = buscar_id(ids[s]);
+        if (k == -1 or por_id[k].second != indices[s]) falla("por_id");
+        suma += mems[s];
+        if (tiempos[s] < menor) menor = tiempos[s];
+    }
+    if (cursor > free_max.second) falla("capacidad");
+    else if (n > 0 and cursor < free_max.second) esperados.insert(make_pair(free_max.second - cursor, cursor));
+    if (suma != ocupada) falla("ocupada");
+    if (free_max.first < ocupada) falla("free_max");
+    if (fin > menor) falla("proximo_fin");
+    set<pair<int, int> > reales;
+    for (map<int, set<int> >::const_iterator it = mmem.begin(); it != mmem.end(); ++it) {
+        if (it->second.empty()) falla("hueco sin indices");
+        if (it->first == 0) continue;       //la compactación deja el hueco final aunque sea de tamaño 0
+        for (set<int>::const_iterator k = it->second.begin(); k != it->second.end(); ++k) reales.insert(make_pair(it->first, *k));
+    }
+    if (reales != esperados) falla("huecos");
+    return fallos;
+}
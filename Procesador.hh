@@ -7,11 +7,16 @@
 #define PROCESADOR_HH
 
 #include "Proceso.hh"
+#include "Registro.hh"
 #ifndef NO_DIAGRAM
 #include <utility>
 #include <set>
 #include <map>
 #include <vector>
+#include <string>
+#include <sstream>
+#include <memory>
+#include <climits>
 #endif
 using namespace std;
 /** @class Procesador
@@ -19,26 +24,155 @@ using namespace std;
 */
 class Procesador {
 
+public:
+    /** @brief Copia de sólo lectura de lo que escribe escribir()
+
+      texto es el texto ya formateado si lo había (compartido e inmutable); si no,
+      procesos contiene los procesos con su índice, en orden */
+    struct Instantanea {
+        shared_ptr<const string> texto;
+        vector<pair<int, Proceso> > procesos;
+    };
+
 private:
     /** @brief String con el identificador del procesador */
     string id;
 
-    /** @brief Pair con memoria libre y memoria maxima del procesador
+    /** @brief Pair con memoria ocupada (desfasada) y memoria maxima del procesador
      
-      first = entero con memoria libre, 
+      first = memoria de los procesos añadidos menos la de los eliminados; las
+      finalizaciones (avanzar_tiempo) no la descuentan, así que tras acabar algún
+      proceso es mayor que ocupada. Se mantiene así a propósito: MEM_libre() la usa
+      para desempatar la búsqueda de procesador y las salidas existentes dependen de
+      ese desempate. La memoria realmente ocupada es ocupada,
       second = entero con capacidad/memoria máxima del procesador 
     */
     pair <int, int> free_max; //mem_ocupada + mem_max
 
-    /** @brief Mapa de indices de cada proceso ordenado crecientemente por su id */
-    map <int, int> mjob;
+    /** @brief Memoria ocupada por los procesos en ejecución */
+    int ocupada;
+
+    /** @brief Cota inferior del menor tiempo restante de los procesos (INT_MAX si no hay)
 
-    /** @brief Mapa del los huecos de memoria con la posicion para cada tamaño */
+      Exacta tras avanzar el tiempo; añadir procesos la mantiene exacta y eliminarlos
+      sólo puede dejarla por debajo del valor real */
+    int fin;
+
+    /** @brief Mapa del los huecos de memoria con la posicion para cada tamaño
+
+      Vacío mientras el procesador está inactivo (sin procesos): entonces toda la
+      memoria es un único hueco implícito en el índice 0 y no se reserva nada */
     map <int, set<int> > mmem; //key = hueco de espacio, value = indices de los huecos libres de memoria
 
-     /** @brief Mapa del los procesos del procesador ordenado por lo indices de menor a mayor */
-    map <int, Proceso> mpos; //key = ind del proceso, value = proceso
-    
+    /** @brief Columnas de los procesos en ejecución ordenadas por índice de memoria (estructura de vectores)
+
+      La posición s de cada columna es el s-ésimo proceso por índice: su índice de
+      memoria, su id, su memoria y su tiempo restante. No hay ningún nodo por proceso
+      (16 bytes por proceso más la holgura de los vectores); a cambio, colocar o quitar
+      un proceso desplaza en las columnas los de índice mayor */
+    vector<int> indices, ids, mems, tiempos;
+
+    /** @brief Pares (id, índice de memoria) de los procesos ordenados por id
+
+      Sustituye al mapa de ids: 8 bytes por proceso; colocar o quitar un proceso
+      desplaza los de id mayor */
+    vector<pair<int, int> > por_id;
+
+    /** @brief Registro de eventos en el que se anotan los cambios del p.i., nulo si no hay */
+    Registro* reg;
+
+    /** @brief Índice del p.i. en reg */
+    int nreg;
+
+    /** @brief Indica si los procesos escritos por escribir() han cambiado desde la última escritura de cambios */
+    bool modificado;
+
+    /** @brief Texto de escribir() ya formateado, nulo si los procesos han cambiado desde que se formateó */
+    mutable shared_ptr<const string> texto;
+
+    /** @brief Marca el p.i. como modificado
+
+        \pre <em>cierto</em>
+        \post modificado es cierto y el texto formateado queda invalidado
+        \coste Constante
+    */
+    void tocar();
+
+    /** @brief Posición en las columnas del primer proceso de índice >= ind
+
+        \pre <em>cierto</em>
+        \post El resultado es el número de procesos de índice menor que ind
+        \coste Logarítmico
+    */
+    int posicion(int ind) const;
+
+    /** @brief Posición en por_id de un proceso
+
+        \pre <em>cierto</em>
+        \post El resultado es la posición en por_id del proceso con ID = id, -1 si no existe
+        \coste Logarítmico
+    */
+    int buscar_id(int id) const;
+
+    /** @brief Cambia el índice de memoria guardado en por_id de un proceso
+
+        \pre Existe un proceso con ID = id
+        \post El índice del proceso en por_id es ind
+        \coste Logarítmico
+    */
+    void mover_id(int id, int ind);
+
+    /** @brief Quita de por_id un conjunto de procesos
+
+        \pre q contiene ids de procesos de por_id, sin repetir
+        \post por_id ya no contiene los procesos de q (q queda ordenado)
+        \coste Logarítmico si q tiene un solo id, lineal sobre por_id más q log q si no
+    */
+    void quitar_ids(vector<int>& q);
+
+    /** @brief Quita un hueco del mapa de huecos
+
+        \pre Existe en mmem un hueco de tamaño tam en el índice ind
+        \post El p.i. ya no contiene ese hueco (ni la llave tam si se queda vacía)
+        \coste Logarítmico
+    */
+    void quitar_hueco(int ind, int tam);
+
+    /** @brief Guarda explícitamente el hueco de un procesador inactivo
+
+        \pre <em>cierto</em>
+        \post Si el p.i. no tiene procesos, mmem contiene el hueco de toda la memoria;
+        si no, no cambia
+        \coste Constante
+    */
+    void materializar();
+
+    /** @brief Libera en una sola pasada ordenada un conjunto de procesos
+
+        \pre t >= 0, borrar no es vacío y sus elementos son posiciones de las columnas,
+        crecientes y sin repetir; si t > 0, ya se ha restado t al tiempo restante de
+        todos los procesos
+        \post Se han eliminado los procesos de las posiciones de borrar: si t = 0 se
+        eliminan y si no acaban en el avance de tiempo t. Cada zona libre resultante
+        entre dos procesos supervivientes consecutivos es un único hueco de mmem
+        \coste Lineal sobre las columnas desde la primera posición de borrar (un solo
+        desplazamiento de los supervivientes) más el coste de quitar_ids(), con
+        operaciones logarítmicas sólo sobre los huecos afectados
+    */
+    void liberar(int t, const vector<int>& borrar);
+
+    /** @brief Busca la compactación parcial más barata que abre un hueco de tamaño mem
+
+        \pre mem > 0
+        \post Si desplazar un tramo contiguo de procesos hacia el final del proceso
+        anterior al tramo crea un hueco >= mem, a es la posición en las columnas del
+        primer proceso del tramo de menor memoria desplazada (el de menor índice en
+        caso de empate), b la siguiente a la del último, movido es la memoria
+        desplazada y devuelve true; en caso contrario devuelve false
+        \coste Lineal sobre el número de procesos (dos punteros)
+    */
+    bool tramo_parcial(int mem, int& a, int& b, int& movido) const;
+
 public:
     //Constructoras
 
@@ -64,12 +198,22 @@ public:
 
     //Modificadoras
 
+    /** @brief Fija el registro de eventos del procesador
+
+        \pre <em>cierto</em>
+        \post Las colocaciones, finalizaciones, eliminaciones y desplazamientos de
+        procesos del p.i. se anotan en r (en ninguno si r es nulo)
+        \coste Constante en promedio
+    */
+    void fijar_registro(Registro* r);
+
     /** @brief Avanza el tiempo del procesador 
      
         \pre El p.i. (P) está inicializado, t > 0
         \post El p.i. contiene los procesos con T - t > 0, 
         en caso que los procesos son eliminados T - t <= 0 los procesos son eliminados
-        \coste Lineal (todo el mapa) sobre logaritmico (eliminar_job) 
+        \coste Lineal (un recorrido de la columna de tiempos), más la liberación de la zona
+        de los procesos que acaban, cuyos huecos se fusionan una sola vez por zona liberada
     */
     void avanzar_tiempo(int t);
     
@@ -78,29 +222,64 @@ public:
         \pre El p.i. (P) está inicializado, la memoria de p es menor 
         o igual a la memoria actual de P
         \post El p.i. contiene sus procesos originales más p 
-        \coste Logarítmico ,sobre 2 más logarítmicos (en caso de caber)
+        \coste Logarítmico más lineal sobre los procesos de índice o id mayor que
+        p, que se desplazan en las columnas y en por_id
     */
     void add_job(const Proceso& p);
 
+    /** @brief Añade un bloque de procesos al procesador
+
+        \pre El p.i. (P) está inicializado
+        \post Se ha intentado añadir cada proceso de v en el orden de v como con add_job():
+        los que ya existían en P o en P tras los anteriores de v se han descartado
+        con un mensaje de error, igual que los que no caben
+        \coste n log n (ordenación de los ids de v) más lineal (recorrido de por_id)
+        más n veces el coste de add_job()
+    */
+    void add_jobs(const vector<Proceso>& v);
+
     /** @brief Elimina un proceso del procesador 
      
-        \pre Existe un proceso en el p.i. con ID = id,
-        it puede estar referenciando a un valor o no
-        \post El p.i. contiene sus procesos originales menos el proceso con ID = id
-        y it apunta al siguiente valor de el elemento borrado
-        \coste Logarítmico 
+        \pre <em>cierto</em>
+        \post El p.i. contiene sus procesos originales menos el proceso con ID = id;
+        si no existe se ha escrito un mensaje de error
+        \coste Logarítmico más lineal sobre los procesos de índice o id mayor, que
+        se desplazan en las columnas y en por_id
+    */
+    void eliminar_job(int id);
+
+    /** @brief Elimina un conjunto de procesos del procesador
+
+        \pre <em>cierto</em>
+        \post El p.i. contiene sus procesos originales menos los de ids; por cada
+        id que no existe (o ya aparecía antes en ids) se ha escrito un mensaje de error
+        \coste Lineal en ids sobre logarítmico (más la ordenación de las posiciones)
+        más el coste de liberar()
     */
-    void eliminar_job(int id, map <int,Proceso>::iterator& it);
+    void eliminar_jobs(const vector<int>& ids);
 
     /** @brief Compacta la memoria del procesador 
      
         \pre <em>cierto</em>
         \post El p.i. contiene los procesos originales desplazados 
         al inicio de la memoria por orden de indice (uno detras de otro)
-        \coste Lineal sobre el número de procesos más logarítmico (busqueda en map)
+        \coste Lineal sobre el número de procesos (recorrido de las columnas, que ya
+        están en orden de índice) más logarítmico por proceso desplazado (por_id)
     */
     void compactar_mem();
 
+    /** @brief Compacta sólo lo necesario para abrir un hueco de tamaño mem
+
+        \pre mem > 0
+        \post Si es posible, el p.i. contiene sus procesos originales con el tramo
+        contiguo más barato (consultar coste_parcial()) desplazado hacia direcciones
+        menores, dejando detrás un único hueco >= mem, devuelve la memoria desplazada
+        y procesos es el número de procesos desplazados; en caso contrario el p.i. no
+        cambia y devuelve -1
+        \coste Lineal sobre el número de procesos más logarítmico por proceso desplazado
+    */
+    int compactar_parcial(int mem, int& procesos);
+
     /** @brief Determina si el proceso cabe en el procesador 
      
         \pre <em>cierto</em>
@@ -108,14 +287,113 @@ public:
         a la llave del mapa de huecos encontrado, retorna false en caso contrario
         \coste Logarítmico 
     */
-    bool hueco(int mem, int& hueco);
+    bool hueco(int mem, int& hueco) const;
 
     //Consultoras
 
+    /** @brief Consulta el coste de una compactación parcial
+
+        \pre mem > 0
+        \post El resultado es la memoria que desplazaría compactar_parcial(mem),
+        -1 si no es posible abrir un hueco de tamaño mem
+        \coste Lineal sobre el número de procesos
+    */
+    int coste_parcial(int mem);
+
+    /** @brief Consulta el coste de una compactación completa
+
+        \pre <em>cierto</em>
+        \post El resultado es la memoria que desplazaría compactar_mem() y procesos
+        el número de procesos que desplazaría
+        \coste Lineal sobre el número de procesos
+    */
+    int coste_compactar(int& procesos) const;
+
+    /** @brief Comprueba los invariantes de la representación
+
+        \pre <em>cierto</em>
+        \post Por cada invariante que no se cumple (columnas ordenadas por índice y
+        por_id ordenado por id y coherente con ellas,
+        procesos sin solaparse dentro de la memoria, ocupada, proximo_fin() y mmem con
+        exactamente los huecos entre procesos, aparte de los de tamaño 0) se ha escrito una línea
+        "error: invariante <id> <qué>"; el resultado es cuántas
+        \coste n log n sobre los procesos (consultas de por_id) y sobre los huecos
+    */
+    int comprobar() const;
+
+    /** @brief Consulta el mayor hueco del procesador
+
+        \pre <em>cierto</em>
+        \post El resultado es el tamaño del mayor hueco de memoria del p.i.
+        \coste Constante
+    */
+    int max_hueco() const;
+
+    /** @brief Consulta el menor hueco de cada clase de tamaño
+
+        \pre <em>cierto</em>
+        \post Para cada c < v.size(), v[c] es el tamaño del menor hueco del p.i. de
+        tamaño al menos 2^c, INT_MAX si no hay ninguno
+        \coste Logarítmico por cada clase
+    */
+    void menores_huecos(vector<int>& v) const;
+
+    /** @brief Consulta la capacidad del procesador
+
+        \pre <em>cierto</em>
+        \post El resultado es la memoria máxima del p.i.
+        \coste Constante
+    */
+    int MEM_max() const;
+
+    /** @brief Consulta los procesos del procesador
+
+        \pre <em>cierto</em>
+        \post v contiene los procesos del p.i. por orden creciente de índice de memoria
+        \coste Lineal
+    */
+    void consultar_procesos(vector<Proceso>& v) const;
+
+    /** @brief Consulta los huecos del procesador
+
+        \pre <em>cierto</em>
+        \post v contiene el tamaño de cada hueco no vacío del p.i.
+        \coste Lineal sobre el número de huecos
+    */
+    void consultar_huecos(vector<int>& v) const;
+
+    /** @brief Consulta la memoria ocupada por los procesos del procesador
+
+        \pre <em>cierto</em>
+        \post El resultado es la suma de la memoria de los procesos en ejecución del p.i.
+        \coste Constante
+    */
+    int MEM_ocupada() const;
+
+    /** @brief Consulta la próxima finalización del procesador
+
+        \pre <em>cierto</em>
+        \post El resultado es una cota inferior del menor tiempo restante de los
+        procesos del p.i., exacta si no se ha eliminado ningún proceso desde el último
+        avance de tiempo; INT_MAX si no tiene procesos
+        \coste Constante
+    */
+    int proximo_fin() const;
+
+    /** @brief Consulta el número de procesos del procesador
+
+        \pre <em>cierto</em>
+        \post El resultado es el número de procesos en ejecución del p.i.
+        \coste Constante
+    */
+    int num_procesos() const;
+
     /** @brief Consulta la memoria libre del procesador 
      
         \pre <em>cierto</em>
-        \post Devuelve la resta de la memoria maxima menos la memoria ocupada
+        \post Devuelve la resta de la memoria maxima menos free_max.first, que no
+        descuenta los procesos acabados: tras alguna finalización es menor que
+        MEM_max() - MEM_ocupada() (consultar free_max)
         \coste Constante
     */
     int MEM_libre() const;
@@ -136,6 +414,16 @@ public:
     */
     bool existe_job(int id) const;
 
+    /** @brief Consultora de cambios pendientes de escribir
+
+      \pre <em>cierto</em>
+      \post El resultado indica si los procesos del p.i. han cambiado (índice,
+      proceso o tiempo restante) desde la última llamada a escribir_cambios(), o
+      desde su creación
+      \coste Constante
+    */
+    bool con_cambios() const;
+
     /** @brief Consultora si el procesador esta activo
      
       \pre <em>cierto</em>
@@ -152,8 +440,34 @@ public:
       \pre <em>cierto</em>
       \post Se han escrito los atributos del parámetro implícito en el canal
       standard de salida.
-      \coste Lineal 
+      \coste Lineal la primera vez tras un cambio (se guarda el texto formateado),
+      constante más el tamaño del texto en las siguientes
     */
     void escribir() const;
+
+    /** @brief Toma una copia de sólo lectura del procesador
+
+      \pre <em>cierto</em>
+      \post s permite escribir lo mismo que escribir() en el estado actual del p.i.
+      (consultar escribir(ostream&, const Instantanea&))
+      \coste Constante si el texto ya está formateado, lineal (copia de los procesos) si no
+    */
+    void instantanea(Instantanea& s) const;
+
+    /** @brief Operación de escritura de una copia de un procesador
+
+      \pre s es una copia tomada con instantanea()
+      \post Se ha escrito en os lo que escribía escribir() al tomar s
+      \coste Lineal respecto al tamaño del texto
+    */
+    static void escribir(ostream& os, const Instantanea& s);
+
+    /** @brief Operación de escritura de los cambios
+
+      \pre <em>cierto</em>
+      \post Se ha hecho escribir() y el p.i. deja de tener cambios pendientes
+      \coste Lineal si ha cambiado desde la última escritura, constante si no
+    */
+    void escribir_cambios();
 };
 #endif
\ No newline at end of file
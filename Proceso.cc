@@ -5,13 +5,24 @@
 #include "Proceso.hh"
 
 Proceso::Proceso() {
+    t_entrada = 0;
+}
 
+Proceso::Proceso(int id, int m, int t) {
+    this->id = id;
+    mem = m;
+    t_ejec = t;
+    t_entrada = 0;
 }
 
 void Proceso::restar_tiempo(int t) {
     t_ejec -= t;
 }
 
+void Proceso::fijar_entrada(int t) {
+    t_entrada = t;
+}
+
 int Proceso::consultar_ID() const{
     return id;
 }
@@ -24,10 +35,18 @@ int Proceso::consultar_tiempo() const {
     return t_ejec;
 }
 
+int Proceso::consultar_entrada() const {
+    return t_entrada;
+}
+
 void Proceso::leer() {
     cin >> id >> mem >> t_ejec;    
 }
 
 void Proceso::escribir() const {
     cout << id << ' ' << mem << ' ' << t_ejec << endl;
-}
\ No newline at end of file
+}
+
+void Proceso::escribir(ostream& os) const {
+    os << id << ' ' << mem << ' ' << t_ejec << '\n';
+}
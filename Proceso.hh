@@ -28,6 +28,9 @@ private:
     /** @brief Memoria del proceso */
     int mem;
 
+    /** @brief Instante del reloj simulado en el que el proceso entró en el área de espera */
+    int t_entrada;
+
 public:
     //Constructoras
 
@@ -40,6 +43,15 @@ public:
     */
     Proceso();
 
+    /** @brief Creadora con valores concretos.
+
+        \pre m > 0, t > 0
+        \post El resultado es un proceso con id "id", memoria "m", tiempo de
+        ejecución restante "t" e instante de entrada 0
+        \coste Constante
+    */
+    Proceso(int id, int m, int t);
+
     //Modificadoras
 
     /** @brief Resta el tiempo de ejecución del proceso
@@ -50,6 +62,14 @@ public:
   */
     void restar_tiempo(int t);
 
+    /** @brief Fija el instante de entrada del proceso en el área de espera
+
+      \pre t >= 0
+      \post El instante de entrada del p.i. pasa a ser t
+      \coste Constante
+  */
+    void fijar_entrada(int t);
+
     //Consultoras
 
     /** @brief Consultora del id del proceso
@@ -73,6 +93,14 @@ public:
     */
     int consultar_tiempo() const;
 
+    /** @brief Consultora del instante de entrada en el área de espera
+        \pre <em>cierto</em>
+        \post El resultado es el instante del reloj simulado en el que el p.i.
+        entró en el área de espera
+        \coste Constante
+    */
+    int consultar_entrada() const;
+
     //Lectura y escritura
 
     /** @brief Operación de lectura
@@ -93,5 +121,14 @@ public:
     */
     void escribir() const;
 
+    /** @brief Operación de escritura en un canal
+
+      \pre <em>cierto</em>
+      \post Se han escrito los atributos del parámetro implícito en el canal os,
+      con el mismo formato que escribir()
+      \coste Constante
+    */
+    void escribir(ostream& os) const;
+
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+/** @file Proyeccion.cc
+    @brief Código de la clase Proyeccion
+*/
+
+#include "Proyeccion.hh"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+
+/** @brief Escribe un error de E/S de la proyección y aborta */
+static void fallo(const char* que) {
+    cerr << "error: no se puede " << que << " el fichero temporal" << endl;
+    abort();
+}
+
+Proyeccion::Proyeccion() {
+    fd = -1;
+    base = nullptr;
+    tam = 0;
+}
+
+Proyeccion::Proyeccion(const Proyeccion& p) {
+    fd = -1;
+    base = nullptr;
+    tam = 0;
+    *this = p;
+}
+
+Proyeccion& Proyeccion::operator=(const Proyeccion& p) {
+    if (this != &p) {
+        cerrar();
+        if (p.tam > 0) {
+            redimensionar(p.tam);
+            const long long TROZO = 1 << 20;    //se copia y se suelta por trozos
+            for (long long a = 0; a < p.tam; a += TROZO) {
+                long long b = (p.tam - a < TROZO) ? p.tam : a + TROZO;
+                memcpy(base + a, p.base + a, b - a);
+                soltar(a, b);
+                p.soltar(a, b);
+            }
+        }
+    }
+    return *this;
+}
+
+Proyeccion::~Proyeccion() {
+    cerrar();
+}
+
+void Proyeccion::redimensionar(long long b) {
+    if (fd == -1) {
+        const char* dir = getenv("TMPDIR");
+        string nombre = string(dir != nullptr ? dir : "/tmp") + "/proyeccionXXXXXX";
+        fd = mkstemp(&nombre[0]);
+        if (fd == -1) fallo("crear");
+        unlink(nombre.c_str());     //se borra solo al cerrarlo
+    }
+    if (base != nullptr) munmap(base, tam);     //el contenido sigue en el fichero
+    base = nullptr;
+    if (ftruncate(fd, off_t(b)) != 0) fallo("redimensionar");
+    void* p = mmap(nullptr, b, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) fallo("proyectar");
+    base = static_cast<char*>(p);
+    tam = b;
+}
+
+void Proyeccion::intercambiar(Proyeccion& q) {
+    swap(fd, q.fd);
+    swap(base, q.base);
+    swap(tam, q.tam);
+}
+
+void Proyeccion::cerrar() {
+    if (base != nullptr) munmap(base, tam);
+    if (fd != -1) close(fd);
+    fd = -1;
+    base = nullptr;
+    tam = 0;
+}
+
+char* Proyeccion::datos() const {
+    return base;
+}
+
+long long Proyeccion::bytes() const {
+    return tam;
+}
+
+void Proyeccion::soltar(long long a, long long b) const {
+    if (a >= b) return;
+    long long pag = sysconf(_SC_PAGESIZE);
+    long long x = a / pag * pag;                        //páginas con algún byte de [a, b)
+    long long y = (b + pag - 1) / pag * pag;
+    if (y > tam) y = tam;
+    madvise(base + x, y - x, MADV_DONTNEED);            //proyección compartida: el contenido sigue en el fichero
+}
@@ -0,0 +1,123 @@
+/** @file Proyeccion.hh
+    @brief Especificación de la clase Proyeccion
+*/
+
+#ifndef PROYECCION_HH
+#define PROYECCION_HH
+
+#ifndef NO_DIAGRAM
+#include <iostream>
+#endif
+using namespace std;
+
+/** @class Proyeccion
+    @brief Fichero temporal proyectado en memoria
+
+    Zona de memoria respaldada por un fichero temporal (ya borrado, desaparece al
+    cerrarlo) en lugar de por memoria anónima: las páginas que se sueltan dejan de
+    ser residentes para el proceso y su contenido se vuelve a leer del fichero (o
+    de la caché de disco del sistema) la próxima vez que se usan. Un error de
+    entrada/salida es irrecuperable: se escribe un mensaje y se aborta.
+*/
+class Proyeccion {
+
+private:
+    /** @brief Descriptor del fichero, -1 si todavía no se ha creado */
+    int fd;
+
+    /** @brief Inicio de la proyección, nulo si no hay */
+    char* base;
+
+    /** @brief Tamaño en bytes del fichero y de la proyección */
+    long long tam;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es una proyección de 0 bytes, sin fichero
+        \coste Constante
+    */
+    Proyeccion();
+
+    /** @brief Creadora copiadora.
+
+        \pre <em>cierto</em>
+        \post El resultado tiene el mismo contenido que p, en un fichero propio
+        \coste Lineal respecto al tamaño de p
+    */
+    Proyeccion(const Proyeccion& p);
+
+    /** @brief Asignación.
+
+        \pre <em>cierto</em>
+        \post El p.i. tiene el mismo contenido que p, en un fichero propio
+        \coste Lineal respecto al tamaño de p
+    */
+    Proyeccion& operator=(const Proyeccion& p);
+
+    /** @brief Destructora.
+
+        \pre <em>cierto</em>
+        \post Se han cerrado la proyección y el fichero, que se borra
+        \coste Constante
+    */
+    ~Proyeccion();
+
+    //Modificadoras
+
+    /** @brief Cambia el tamaño
+
+        \pre b > 0
+        \post El p.i. tiene b bytes: los min(b, tamaño anterior) primeros no cambian
+        y el resto valen 0. Los punteros obtenidos con datos() dejan de ser válidos
+        \coste Constante más lo que tarde el sistema en cambiar el fichero
+    */
+    void redimensionar(long long b);
+
+    /** @brief Intercambia dos proyecciones
+
+        \pre <em>cierto</em>
+        \post El p.i. tiene el fichero y el contenido que tenía q y al revés
+        \coste Constante
+    */
+    void intercambiar(Proyeccion& q);
+
+    /** @brief Cierra el fichero y la proyección
+
+        \pre <em>cierto</em>
+        \post El p.i. tiene 0 bytes, sin fichero
+        \coste Constante
+    */
+    void cerrar();
+
+    //Consultoras
+
+    /** @brief Consulta el inicio de la proyección
+
+        \pre <em>cierto</em>
+        \post El resultado apunta al primer byte del p.i., nulo si tiene 0 bytes
+        \coste Constante
+    */
+    char* datos() const;
+
+    /** @brief Consulta el tamaño
+
+        \pre <em>cierto</em>
+        \post El resultado es el número de bytes del p.i.
+        \coste Constante
+    */
+    long long bytes() const;
+
+    /** @brief Devuelve al sistema páginas de la proyección
+
+        \pre 0 <= a <= b <= bytes()
+        \post Las páginas que contienen algún byte de [a, b) ya no son residentes para
+        el p.i.; su contenido no cambia
+        \coste Lineal respecto al número de páginas
+    */
+    void soltar(long long a, long long b) const;
+};
+#endif
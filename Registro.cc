@@ -0,0 +1,111 @@
+/** @file Registro.cc
+    @brief Código de la clase Registro
+*/
+
+#include "Registro.hh"
+#include <chrono>
+
+Registro::Registro(FILE* f) : anillo(CAP) {
+    escritos.store(0, memory_order_relaxed);
+    leidos.store(0, memory_order_relaxed);
+    leidos_prod = 0;
+    acabar.store(false, memory_order_relaxed);
+    ahora = 0;
+    this->f = f;
+    escritor = thread(&Registro::escribir_eventos, this);
+}
+
+Registro::~Registro() {
+    acabar.store(true, memory_order_release);
+    escritor.join();
+    fclose(f);
+}
+
+int Registro::procesador(const string& id) {
+    unordered_map<string, int>::const_iterator it = indices.find(id);
+    if (it != indices.end()) return it->second;
+    lock_guard<mutex> l(mnom);          //el escritor copia los nombres nuevos bajo el mismo cerrojo
+    int i = nombres.size();
+    nombres.push_back(id);
+    indices[id] = i;
+    return i;
+}
+
+void Registro::fijar_tiempo(int t) {
+    ahora = t;
+}
+
+int Registro::tiempo() const {
+    return ahora;
+}
+
+void Registro::anotar(Tipo tipo, int t, int prc, int job, int a, int b) {
+    unsigned long long e = escritos.load(memory_order_relaxed);
+    if (e - leidos_prod == CAP) {       //anillo lleno según la última copia: se relee
+        leidos_prod = leidos.load(memory_order_acquire);
+        while (e - leidos_prod == CAP) {
+            this_thread::yield();
+            leidos_prod = leidos.load(memory_order_acquire);
+        }
+    }
+    Evento& ev = anillo[e & (CAP - 1)];
+    ev.tipo = tipo;
+    ev.t = t;
+    ev.prc = prc;
+    ev.job = job;
+    ev.a = a;
+    ev.b = b;
+    escritos.store(e + 1, memory_order_release);       //el evento ya es visible para el escritor
+}
+
+/** @brief Añade a b la representación decimal de x seguida del carácter c; devuelve el final */
+static char* poner(char* b, int x, char c) {
+    char tmp[12];
+    int n = 0;
+    unsigned int u = x < 0 ? -(unsigned int)x : x;
+    do {
+        tmp[n++] = '0' + u % 10;
+        u /= 10;
+    } while (u != 0);
+    if (x < 0) *b++ = '-';
+    while (n > 0) *b++ = tmp[--n];
+    *b++ = c;
+    return b;
+}
+
+void Registro::escribir_eventos() {
+    vector<string> nom;         //copia local de los nombres, crece cuando aparece un índice nuevo
+    unsigned long long l = leidos.load(memory_order_relaxed);
+    while (true) {
+        bool fin = acabar.load(memory_order_acquire);
+        unsigned long long e = escritos.load(memory_order_acquire);
+        if (l == e) {
+            if (fin) break;         //acabar se lee antes que escritos: no queda nada por escribir
+            this_thread::sleep_for(chrono::microseconds(200));
+            continue;
+        }
+        for (; l != e; ++l) {
+            const Evento& ev = anillo[l & (CAP - 1)];
+            if (ev.prc >= nom.size()) {
+                lock_guard<mutex> g(mnom);
+                nom.assign(nombres.begin(), nombres.end());
+            }
+            static const char* const nombre_tipo[] = {"coloca ", "acaba ", "elimina ", "mueve "};
+            char b[64];             //formato propio: evita el coste de fprintf en el hilo escritor
+            char* q = poner(b, ev.t, ' ');
+            fwrite_unlocked(b, 1, q - b, f);
+            fputs_unlocked(nombre_tipo[ev.tipo], f);
+            const string& p = nom[ev.prc];
+            fwrite_unlocked(p.data(), 1, p.size(), f);
+            q = b;
+            *q++ = ' ';
+            if (ev.tipo == COLOCA) q = poner(poner(q, ev.job, ' '), ev.a, '\n');
+            else if (ev.tipo == MUEVE) q = poner(poner(poner(q, ev.job, ' '), ev.a, ' '), ev.b, '\n');
+            else q = poner(q, ev.job, '\n');
+            fwrite_unlocked(b, 1, q - b, f);
+            if (((l + 1) & 1023) == 0) leidos.store(l + 1, memory_order_release);     //libera espacio por tramos
+        }
+        leidos.store(l, memory_order_release);
+    }
+    fflush(f);
+}
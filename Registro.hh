@@ -0,0 +1,151 @@
+/** @file Registro.hh
+    @brief Especificación de la clase Registro
+*/
+
+#ifndef REGISTRO_HH
+#define REGISTRO_HH
+
+#ifndef NO_DIAGRAM
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#endif
+using namespace std;
+
+/** @class Registro
+    @brief Registro de eventos de la simulación escrito en un fichero por un hilo aparte
+
+    El hilo de la simulación anota cada evento en un anillo de tamaño fijo sin
+    bloquearse (un solo productor y un solo consumidor, sólo con operaciones
+    atómicas) y un hilo escritor los vacía y los escribe en el fichero, una línea
+    por evento: "t coloca prc job pos", "t acaba prc job", "t elimina prc job" o
+    "t mueve prc job desde hasta", donde t es el instante simulado del evento.
+    Sólo si el anillo se llena el productor espera a que el escritor avance.
+*/
+class Registro {
+
+public:
+    /** @brief Tipos de evento */
+    enum Tipo { COLOCA, ACABA, ELIMINA, MUEVE };
+
+private:
+    /** @brief Evento anotado; prc es el índice del procesador en nombres */
+    struct Evento {
+        int tipo;
+        int t;
+        int prc;
+        int job;
+        int a;
+        int b;
+    };
+
+    /** @brief Número de eventos del anillo (potencia de 2) */
+    static const unsigned int CAP = 1 << 16;
+
+    /** @brief Anillo de eventos */
+    vector<Evento> anillo;
+
+    /** @brief Número de eventos anotados (sólo lo modifica el productor) */
+    alignas(64) atomic<unsigned long long> escritos;
+
+    /** @brief Número de eventos ya escritos en el fichero (sólo lo modifica el escritor) */
+    alignas(64) atomic<unsigned long long> leidos;
+
+    /** @brief Copia de leidos del productor, para no leer el atómico en cada evento */
+    alignas(64) unsigned long long leidos_prod;
+
+    /** @brief Indica al escritor que no habrá más eventos */
+    atomic<bool> acabar;
+
+    /** @brief Instante simulado actual, lo fija el clúster */
+    int ahora;
+
+    /** @brief Índice de cada procesador registrado (sólo lo usa el productor) */
+    unordered_map<string, int> indices;
+
+    /** @brief Nombres de los procesadores según su índice, protegidos por mnom */
+    vector<string> nombres;
+
+    /** @brief Exclusión mutua sobre nombres */
+    mutex mnom;
+
+    /** @brief Fichero de salida */
+    FILE* f;
+
+    /** @brief Hilo escritor */
+    thread escritor;
+
+    /** @brief Bucle del hilo escritor
+
+        \pre <em>cierto</em>
+        \post Se han escrito en f todos los eventos anotados hasta que se pide acabar
+        \coste Lineal respecto al número de eventos
+    */
+    void escribir_eventos();
+
+    Registro(const Registro&) = delete;
+    Registro& operator=(const Registro&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora con fichero.
+
+        \pre f es un fichero abierto para escritura
+        \post El resultado es un registro sin eventos que escribe en f (y lo cierra
+        al destruirse) y cuyo instante actual es 0
+        \coste Constante
+    */
+    explicit Registro(FILE* f);
+
+    /** @brief Destructora.
+
+        \pre <em>cierto</em>
+        \post Se han escrito todos los eventos anotados y se ha cerrado el fichero
+        \coste Lineal respecto al número de eventos pendientes
+    */
+    ~Registro();
+
+    //Modificadoras (sólo desde el hilo de la simulación)
+
+    /** @brief Registra un procesador
+
+        \pre <em>cierto</em>
+        \post El resultado es el índice con el que se anotan los eventos del
+        procesador con ID = id (el mismo para el mismo id)
+        \coste Constante en promedio
+    */
+    int procesador(const string& id);
+
+    /** @brief Fija el instante simulado actual
+
+        \pre t >= 0
+        \post El instante actual del p.i. es t
+        \coste Constante
+    */
+    void fijar_tiempo(int t);
+
+    /** @brief Anota un evento
+
+        \pre prc es un índice devuelto por procesador()
+        \post Se ha anotado el evento tipo del proceso job en el procesador prc en
+        el instante t; a y b son la posición (COLOCA) o las posiciones de origen y
+        destino (MUEVE)
+        \coste Constante (salvo si el anillo está lleno)
+    */
+    void anotar(Tipo tipo, int t, int prc, int job, int a = 0, int b = 0);
+
+    //Consultoras
+
+    /** @brief Consulta el instante simulado actual
+        \pre <em>cierto</em>
+        \post El resultado es el instante actual del p.i.
+        \coste Constante
+    */
+    int tiempo() const;
+};
+#endif
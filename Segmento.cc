@@ -0,0 +1,65 @@
+/** @file Segmento.cc
+    @brief Código de la clase Segmento
+*/
+
+#include "Segmento.hh"
+#include <cstring>
+#include <type_traits>
+
+//los procesos se guardan tal cual están en memoria: el fichero sólo lo lee este proceso
+static_assert(is_trivially_copyable<Proceso>::value, "Proceso debe poder copiarse byte a byte");
+
+Segmento::Segmento() {
+    ini = fin = 0;
+}
+
+Proceso* Segmento::procesos() const {
+    return reinterpret_cast<Proceso*>(p.datos());
+}
+
+void Segmento::añadir(const deque<Proceso>& d) {
+    if (d.empty()) return;
+    long long cap = p.bytes() / sizeof(Proceso);
+    if (fin + (long long)d.size() > cap) {
+        long long c = (cap == 0) ? BLOQUE : cap;
+        while (c < fin + (long long)d.size()) c *= 2;
+        p.redimensionar(c * sizeof(Proceso));
+    }
+    Proceso* v = procesos();
+    long long a = fin;
+    for (deque<Proceso>::const_iterator it = d.begin(); it != d.end(); ++it) {
+        memcpy(v + fin, &*it, sizeof(Proceso));
+        ++fin;
+    }
+    p.soltar(a * sizeof(Proceso), fin * sizeof(Proceso));   //lo escrito ya sólo hace falta en el fichero
+}
+
+void Segmento::extraer(deque<Proceso>& d, int n) {
+    if (fin - ini < n) n = fin - ini;
+    if (n <= 0) return;
+    Proceso* v = procesos();
+    d.insert(d.end(), v + ini, v + ini + n);
+    p.soltar(ini * sizeof(Proceso), (ini + n) * sizeof(Proceso));
+    ini += n;
+    if (ini == fin) {           //todo leído: se libera el fichero
+        p.cerrar();
+        ini = fin = 0;
+    }
+}
+
+bool Segmento::vacio() const {
+    return ini == fin;
+}
+
+long long Segmento::tamaño() const {
+    return fin - ini;
+}
+
+void Segmento::escribir(ostream& os) const {
+    Proceso* v = procesos();
+    for (long long pos = ini; pos < fin; pos += BLOQUE) {
+        long long b = (fin - pos < BLOQUE) ? fin : pos + BLOQUE;
+        for (long long i = pos; i < b; ++i) v[i].escribir(os);
+        p.soltar(pos * sizeof(Proceso), b * sizeof(Proceso));
+    }
+}
@@ -0,0 +1,107 @@
+/** @file Segmento.hh
+    @brief Especificación de la clase Segmento
+*/
+
+#ifndef SEGMENTO_HH
+#define SEGMENTO_HH
+
+#include "Proceso.hh"
+#include "Proyeccion.hh"
+#ifndef NO_DIAGRAM
+#include <deque>
+#include <iostream>
+#endif
+using namespace std;
+
+/** @class Segmento
+    @brief Cola de procesos guardada en un fichero temporal proyectado en memoria
+
+    Los procesos se añaden por el final y se sacan por el frente, copiándolos
+    directamente desde la proyección del fichero (sin fread ni fwrite). Después de
+    cada operación se sueltan las páginas de la proyección que se han usado, de
+    forma que el segmento no tiene ninguna residente entre operaciones, sea cual sea
+    su tamaño. El fichero se crea con el primer bloque, crece al doble cuando se
+    llena y se cierra cuando se ha sacado todo su contenido.
+*/
+class Segmento {
+
+private:
+    /** @brief Procesos por bloque en los recorridos */
+    static const int BLOQUE = 4096;
+
+    /** @brief Fichero de los procesos; su capacidad en procesos es su tamaño entre
+        el de un proceso */
+    Proyeccion p;
+
+    /** @brief Posición (en procesos) del primer proceso pendiente de sacar */
+    long long ini;
+
+    /** @brief Posición (en procesos) siguiente al último proceso escrito */
+    long long fin;
+
+    /** @brief Consulta los procesos del fichero
+
+        \pre <em>cierto</em>
+        \post El resultado apunta al proceso de la posición 0 del fichero
+        \coste Constante
+    */
+    Proceso* procesos() const;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un segmento vacío, sin fichero
+        \coste Constante
+    */
+    Segmento();
+
+    //Modificadoras
+
+    /** @brief Añade procesos al final del segmento
+
+        \pre <em>cierto</em>
+        \post Los procesos de d se han añadido, en su orden, al final del p.i.
+        \coste Lineal respecto al tamaño de d (amortizado: el fichero crece al doble)
+    */
+    void añadir(const deque<Proceso>& d);
+
+    /** @brief Saca procesos del frente del segmento
+
+        \pre n > 0
+        \post Se han sacado del p.i. los min(n, tamaño) primeros procesos y se han
+        añadido, en su orden, al final de d
+        \coste Lineal respecto al número de procesos sacados
+    */
+    void extraer(deque<Proceso>& d, int n);
+
+    //Consultoras
+
+    /** @brief Consulta si el segmento está vacío
+        \pre <em>cierto</em>
+        \post El resultado indica si el p.i. no tiene procesos
+        \coste Constante
+    */
+    bool vacio() const;
+
+    /** @brief Consulta el número de procesos del segmento
+        \pre <em>cierto</em>
+        \post El resultado es el número de procesos del p.i.
+        \coste Constante
+    */
+    long long tamaño() const;
+
+    //Lectura y escritura
+
+    /** @brief Operación de escritura
+
+        \pre <em>cierto</em>
+        \post Se han escrito los procesos del p.i., del frente al final, en el canal os
+        con el formato de escribir() de Proceso
+        \coste Lineal respecto al número de procesos
+    */
+    void escribir(ostream& os) const;
+};
+#endif
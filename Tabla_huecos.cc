@@ -0,0 +1,150 @@
+/** @file Tabla_huecos.cc
+    @brief Código de la clase Tabla_huecos
+*/
+
+#include "Tabla_huecos.hh"
+#ifndef NO_DIAGRAM
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#endif
+
+Tabla_huecos::Tabla_huecos() {
+    n = 0;
+    aux = vector<int>(CLASES);
+}
+
+int Tabla_huecos::clase_de(int m) {
+    int c = 31 - __builtin_clz(m);
+    return c < CLASES ? c : CLASES - 1;
+}
+
+void Tabla_huecos::redimensionar(int n) {
+    this->n = n;
+    mayor.assign(n, 0);
+    libre.assign(n, 0);
+    clase.assign((size_t)CLASES * n, INT_MAX);
+}
+
+void Tabla_huecos::fijar(int i, const Procesador& prc) {
+    mayor[i] = prc.max_hueco();
+    libre[i] = prc.MEM_libre();
+    prc.menores_huecos(aux);
+    for (int c = 0; c < CLASES; ++c) clase[(size_t)c * n + i] = aux[c];
+}
+
+bool Tabla_huecos::acotar(const atomic<int>* cota, int& lim) {
+    int c = cota->load(memory_order_relaxed);
+    if (c == INT_MAX or c + 1 >= lim) return false;
+    lim = c + 1;
+    return true;
+}
+
+bool Tabla_huecos::examinar(int i, int cota, int memo, int id, const int* cl, const Procesador* const* prc,
+                            int& m, int& hollow) const {
+    int h = cota;
+    if (cl[i] < memo) prc[i]->hueco(memo, h);     //la cota es memo: hay que buscar el hueco exacto
+    if (h > hollow) return false;
+    if (m != -1 and h == hollow and libre[i] <= libre[m]) return false;     //mismo criterio que bfs: pierde el empate
+    if (prc[i]->existe_job(id)) return false;       //sólo se busca el id en los que ganarían
+    m = i;
+    hollow = h;
+    return true;
+}
+
+void Tabla_huecos::publicar(atomic<int>* cota, int h) {
+    int c = cota->load(memory_order_relaxed);
+    while (h < c and not cota->compare_exchange_weak(c, h, memory_order_relaxed));
+}
+
+int Tabla_huecos::buscar(int ini, int fin, int memo, int id, const Procesador* const* prc,
+                         atomic<int>* cota) const {
+    const int* mx = mayor.data();
+    const int* cl = clase.data() + (size_t)clase_de(memo) * n;
+    int m = -1;
+    int hollow = INT_MAX;
+    int lim = INT_MAX;          //se examinan las cotas menores que lim: hollow + 1 o la cota de los otros tramos + 1
+    int i = ini;
+    //cota de cada procesador: INT_MAX si no cabe, su menor hueco de la clase si es al menos memo
+    //(entonces es exacto) y memo si no; sólo se examinan los de cota <= hollow
+#if defined(__AVX2__)
+    const __m256i vmenos = _mm256_set1_epi32(memo - 1);
+    const __m256i vmemo = _mm256_set1_epi32(memo);
+    const __m256i vinf = _mm256_set1_epi32(INT_MAX);
+    __m256i vlim = vinf;        //lim en cada carril
+    alignas(32) int cot8[8];
+    for (; i + 8 <= fin; i += 8) {
+        if (cota != nullptr and acotar(cota, lim)) vlim = _mm256_set1_epi32(lim);
+        __m256i h = _mm256_loadu_si256((const __m256i*)(mx + i));
+        __m256i c = _mm256_loadu_si256((const __m256i*)(cl + i));
+        __m256i cabe = _mm256_cmpgt_epi32(h, vmenos);
+        __m256i exacto = _mm256_cmpgt_epi32(c, vmenos);
+        __m256i cot = _mm256_blendv_epi8(vinf, _mm256_blendv_epi8(vmemo, c, exacto), cabe);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vlim, cot)));
+        if (mask == 0) continue;
+        _mm256_store_si256((__m256i*)cot8, cot);
+        while (mask != 0) {
+            int j = __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (cot8[j] < lim and examinar(i + j, cot8[j], memo, id, cl, prc, m, hollow)) {
+                lim = hollow + 1;
+                vlim = _mm256_set1_epi32(lim);
+                if (cota != nullptr) publicar(cota, hollow);
+            }
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i vmenos = _mm_set1_epi32(memo - 1);
+    const __m128i vmemo = _mm_set1_epi32(memo);
+    const __m128i vinf = _mm_set1_epi32(INT_MAX);
+    __m128i vlim = vinf;
+    alignas(16) int cot4[4];
+    for (; i + 4 <= fin; i += 4) {
+        if (cota != nullptr and acotar(cota, lim)) vlim = _mm_set1_epi32(lim);
+        __m128i h = _mm_loadu_si128((const __m128i*)(mx + i));
+        __m128i c = _mm_loadu_si128((const __m128i*)(cl + i));
+        __m128i cabe = _mm_cmpgt_epi32(h, vmenos);
+        __m128i exacto = _mm_cmpgt_epi32(c, vmenos);
+        __m128i cot = _mm_or_si128(_mm_and_si128(exacto, c), _mm_andnot_si128(exacto, vmemo));     //SSE2 no tiene blend
+        cot = _mm_or_si128(_mm_and_si128(cabe, cot), _mm_andnot_si128(cabe, vinf));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(vlim, cot)));
+        if (mask == 0) continue;
+        _mm_store_si128((__m128i*)cot4, cot);
+        while (mask != 0) {
+            int j = __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (cot4[j] < lim and examinar(i + j, cot4[j], memo, id, cl, prc, m, hollow)) {
+                lim = hollow + 1;
+                vlim = _mm_set1_epi32(lim);
+                if (cota != nullptr) publicar(cota, hollow);
+            }
+        }
+    }
+#endif
+    for (; i < fin; ++i) {      //resto (o todo, sin SIMD)
+        if (mx[i] < memo) continue;
+        if (cota != nullptr and (i & 7) == 0) acotar(cota, lim);
+        int c = (cl[i] >= memo) ? cl[i] : memo;
+        if (c < lim and examinar(i, c, memo, id, cl, prc, m, hollow)) {
+            lim = hollow + 1;
+            if (cota != nullptr) publicar(cota, hollow);
+        }
+    }
+    return m;
+}
+
+bool Tabla_huecos::al_dia(int i, const Procesador& prc) const {
+    if (mayor[i] != prc.max_hueco() or libre[i] != prc.MEM_libre()) return false;
+    vector<int> v(CLASES);
+    prc.menores_huecos(v);
+    for (int c = 0; c < CLASES; ++c) {
+        if (clase[(size_t)c * n + i] != v[c]) return false;
+    }
+    return true;
+}
+
+int Tabla_huecos::mayor_hueco(int i) const {
+    return mayor[i];
+}
@@ -0,0 +1,153 @@
+/** @file Tabla_huecos.hh
+    @brief Especificación de la clase Tabla_huecos
+*/
+
+#ifndef TABLA_HUECOS_HH
+#define TABLA_HUECOS_HH
+
+#include "Procesador.hh"
+#ifndef NO_DIAGRAM
+#include <map>
+#include <string>
+#include <vector>
+#include <atomic>
+#endif
+using namespace std;
+
+/** @class Tabla_huecos
+    @brief Resumen de los huecos de cada procesador en columnas contiguas
+
+    Para cada procesador, en el orden breadth-first del cluster, guarda su mayor
+    hueco, su memoria libre y, para cada clase de tamaño c < CLASES, su menor hueco
+    de tamaño al menos 2^c. Cada dato es una columna de enteros (estructura de
+    vectores), de forma que la búsqueda de procesador para un proceso de memoria m
+    recorre sólo dos columnas (la del mayor hueco y la de la clase de m) con
+    instrucciones SIMD (AVX2 o SSE2, según con qué se compile; si no, escalar).
+
+    Si el menor hueco de la clase de m es al menos m, es exactamente el hueco más
+    ajustado para m; si no, es una cota inferior y sólo para ese procesador se
+    consulta su mapa de huecos. Los procesadores cuya cota supera el mejor hueco
+    encontrado hasta el momento se descartan sin tocar el procesador.
+*/
+class Tabla_huecos {
+
+public:
+    /** @brief Número de clases de tamaño (la última incluye todos los tamaños mayores) */
+    static const int CLASES = 16;
+
+private:
+    /** @brief Número de procesadores */
+    int n;
+
+    /** @brief Mayor hueco de cada procesador */
+    vector<int> mayor;
+
+    /** @brief Memoria libre (MEM_libre()) de cada procesador */
+    vector<int> libre;
+
+    /** @brief clase[c * n + i] = menor hueco de tamaño al menos 2^c del procesador i (INT_MAX si no hay) */
+    vector<int> clase;
+
+    /** @brief Espacio para menores_huecos() de Procesador */
+    vector<int> aux;
+
+    /** @brief Clase de tamaño de una memoria
+        \pre m > 0
+        \post El resultado es la mayor clase c < CLASES con 2^c <= m
+        \coste Constante
+    */
+    static int clase_de(int m);
+
+    /** @brief Aplica el mejor hueco de los otros tramos al límite de la búsqueda
+        \pre cota no es nulo
+        \post Si cota + 1 < lim, lim = cota + 1 y el resultado es cierto; si no, es falso
+        \coste Constante
+    */
+    static bool acotar(const atomic<int>* cota, int& lim);
+
+    /** @brief Examina un procesador que la cota no permite descartar
+        \pre cl es la columna de la clase de memo, la cota del procesador i es cota <= hollow
+        y su mayor hueco es al menos memo; m y hollow son el mejor procesador y su hueco
+        entre los examinados antes (-1 e INT_MAX si ninguno)
+        \post Si el procesador i es mejor que m según el criterio de buscar(), m = i,
+        hollow es su hueco y el resultado es cierto; si no, es falso
+        \coste Logarítmico sobre los huecos y los procesos del procesador i
+    */
+    bool examinar(int i, int cota, int memo, int id, const int* cl, const Procesador* const* prc,
+                  int& m, int& hollow) const;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es una tabla sin procesadores
+        \coste Constante
+    */
+    Tabla_huecos();
+
+    //Modificadoras
+
+    /** @brief Cambia el número de procesadores
+
+        \pre n >= 0
+        \post El p.i. tiene n procesadores, todos sin huecos hasta que se fijen
+        \coste Lineal respecto a n
+    */
+    void redimensionar(int n);
+
+    /** @brief Copia el resumen de un procesador
+
+        \pre 0 <= i < número de procesadores del p.i.
+        \post La fila i del p.i. resume los huecos y la memoria libre de prc
+        \coste Logarítmico sobre los huecos de prc por cada clase
+    */
+    void fijar(int i, const Procesador& prc);
+
+    //Consultoras
+
+    /** @brief Consulta si la fila de un procesador está al día
+
+        \pre 0 <= i < número de procesadores del p.i.
+        \post El resultado indica si la fila i del p.i. es la que dejaría fijar(i, prc)
+        \coste Logarítmico sobre los huecos de prc por cada clase
+    */
+    bool al_dia(int i, const Procesador& prc) const;
+
+    /** @brief Consultora del mayor hueco de un procesador
+
+        \pre 0 <= i < número de procesadores del p.i.
+        \post El resultado es el mayor hueco del procesador i según su fila
+        \coste Constante
+    */
+    int mayor_hueco(int i) const;
+
+    /** @brief Busca el procesador para un proceso
+
+        \pre 0 <= ini <= fin <= número de procesadores, memo > 0, prc apunta a los
+        procesadores resumidos en el p.i., en el mismo orden, y las filas del p.i.
+        están al día
+        \post El resultado es la posición i en [ini, fin) del procesador en el que
+        cabe un proceso de memoria memo e id id (sin otro proceso con ese id) con el
+        hueco más ajustado, con más memoria libre en caso de empate y con menor i
+        si el empate sigue; -1 si no cabe en ninguno. Si cota no es nulo, es el mejor
+        hueco que han encontrado hasta el momento los tramos que buscan a la vez en
+        otras partes de prc: se descartan también los procesadores cuya cota la
+        supera (no pueden ganar en el resultado combinado, aunque el resultado deja
+        de ser el de [ini, fin) solo) y se publica en ella cada hueco mejor encontrado
+        \coste Lineal respecto a fin - ini, más logarítmico sobre los huecos de los
+        procesadores cuya cota no basta para descartarlos
+    */
+    int buscar(int ini, int fin, int memo, int id, const Procesador* const* prc,
+               atomic<int>* cota = nullptr) const;
+
+    /** @brief Publica el mejor hueco encontrado por un tramo de la búsqueda
+
+        \pre cota no es nulo
+        \post cota es el mínimo entre su valor anterior y h
+        \coste Constante en ausencia de contención
+    */
+    static void publicar(atomic<int>* cota, int h);
+};
+#endif
@@ -0,0 +1,50 @@
+/** @file Trabajador.cc
+    @brief Código de la clase Trabajador
+*/
+
+#include "Trabajador.hh"
+
+Trabajador::Trabajador() {
+    ocupado = false;
+    acabar = false;
+    hilo = thread(&Trabajador::trabajar, this);
+}
+
+Trabajador::~Trabajador() {
+    {
+        lock_guard<mutex> g(m);
+        acabar = true;
+    }
+    cv_tarea.notify_one();
+    hilo.join();
+}
+
+void Trabajador::trabajar() {
+    unique_lock<mutex> l(m);
+    while (true) {
+        while (cola.empty() and not acabar) cv_tarea.wait(l);
+        if (cola.empty()) break;            //acabar y no queda nada
+        function<void()> f;
+        f.swap(cola.front());
+        cola.pop_front();
+        ocupado = true;
+        l.unlock();
+        f();
+        l.lock();
+        ocupado = false;
+        if (cola.empty()) cv_vacio.notify_all();
+    }
+}
+
+void Trabajador::encargar(const function<void()>& f) {
+    {
+        lock_guard<mutex> g(m);
+        cola.push_back(f);
+    }
+    cv_tarea.notify_one();
+}
+
+void Trabajador::esperar() {
+    unique_lock<mutex> l(m);
+    while (ocupado or not cola.empty()) cv_vacio.wait(l);
+}
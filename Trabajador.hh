@@ -0,0 +1,99 @@
+/** @file Trabajador.hh
+    @brief Especificación de la clase Trabajador
+*/
+
+#ifndef TRABAJADOR_HH
+#define TRABAJADOR_HH
+
+#ifndef NO_DIAGRAM
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#endif
+using namespace std;
+
+/** @class Trabajador
+    @brief Hilo que ejecuta en orden las tareas que se le encargan
+
+    A diferencia de Grupo_hilos, quien encarga una tarea no espera a que acabe:
+    las tareas se ponen en una cola y el hilo las ejecuta una tras otra, en el
+    orden en el que se han encargado, mientras quien las encarga sigue con otras
+    cosas. esperar() espera a que no quede ninguna.
+*/
+class Trabajador {
+
+private:
+    /** @brief Tareas encargadas que aún no han empezado */
+    deque<function<void()> > cola;
+
+    /** @brief Exclusión mutua sobre cola, ocupado y acabar */
+    mutex m;
+
+    /** @brief Aviso al hilo de que hay tareas o de que debe acabar */
+    condition_variable cv_tarea;
+
+    /** @brief Aviso a quien espera de que ya no quedan tareas */
+    condition_variable cv_vacio;
+
+    /** @brief Indica si el hilo está ejecutando una tarea */
+    bool ocupado;
+
+    /** @brief Indica al hilo que no habrá más tareas */
+    bool acabar;
+
+    /** @brief Hilo que ejecuta las tareas */
+    thread hilo;
+
+    /** @brief Bucle del hilo
+
+        \pre <em>cierto</em>
+        \post Ha ejecutado en orden las tareas de la cola hasta que se pide acabar y
+        la cola está vacía
+        \coste Lineal respecto al trabajo de las tareas
+    */
+    void trabajar();
+
+    Trabajador(const Trabajador&) = delete;
+    Trabajador& operator=(const Trabajador&) = delete;
+
+public:
+    //Constructoras
+
+    /** @brief Creadora por defecto.
+
+        \pre <em>cierto</em>
+        \post El resultado es un trabajador sin tareas, con su hilo esperando
+        \coste Constante
+    */
+    Trabajador();
+
+    /** @brief Destructora.
+
+        \pre <em>cierto</em>
+        \post Se han ejecutado todas las tareas encargadas y el hilo ha acabado
+        \coste El de las tareas pendientes
+    */
+    ~Trabajador();
+
+    //Modificadoras
+
+    /** @brief Encarga una tarea
+
+        \pre f sólo usa datos que nadie más usa hasta que se espera al p.i.
+        \post f se ejecutará en el hilo del p.i. después de las tareas encargadas antes
+        \coste Constante amortizado
+    */
+    void encargar(const function<void()>& f);
+
+    /** @brief Espera a que acaben las tareas encargadas
+
+        \pre No se llama desde una tarea del p.i.
+        \post Se han ejecutado todas las tareas encargadas hasta el momento; lo que
+        han hecho es visible para el hilo que llama
+        \coste El de las tareas pendientes
+    */
+    void esperar();
+};
+#endif
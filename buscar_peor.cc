@@ -0,0 +1,285 @@
+/** @file buscar_peor.cc
+    @brief Búsqueda evolutiva de cargas de trabajo de coste máximo para la simulación
+
+    Uso: <em>buscar_peor.exe [-s semilla] [-g generaciones] [-p poblacion]
+    [-n comandos] [-k guardadas] [-o prefijo] [-t]</em>
+
+    Parte de una población de trazas aleatorias (cluster, prioridades y comandos) y
+    en cada generación crea descendientes por mutación y cruce, ejecuta cada traza
+    sobre una federación nueva y se queda con las más costosas.
+    El coste es la suma de los contadores de operaciones (consultar la clase
+    Contadores), determinista para una semilla dada, o con -t el tiempo de
+    ejecución en microsegundos. Al acabar escribe las k trazas más costosas en los
+    ficheros prefijo1.txt ... prefijok.txt, que se pueden volver a ejecutar con
+    program.exe, y por cada una su coste y sus contadores en el canal standard de salida.
+*/
+
+#include "Federacion.hh"
+#include "Comandos.hh"
+#include "Contadores.hh"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+/** @brief Canal de salida que descarta todo lo que se escribe */
+class Descarte : public streambuf {
+protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+/** @brief Traza de la simulación con su coste */
+struct Traza {
+    int nprc;                   //procesadores P1..Pnprc del cluster
+    string arbol;               //cluster en el formato de leer() de Cluster
+    vector<string> cmds;        //comandos, sin el "fin"
+    long long coste;
+    string contadores;          //contadores de la última ejecución, como Contadores::escribir()
+};
+
+/** @brief Prioridades de todas las trazas */
+static const char* const PRIOR[] = {"a", "b", "c"};
+
+/** @brief Generador aleatorio de la búsqueda */
+static mt19937 gen;
+
+/** @brief Entero aleatorio en [a, b] */
+static int azar(int a, int b) {
+    return uniform_int_distribution<int>(a, b)(gen);
+}
+
+/** @brief Genera un subárbol de procesadores
+
+    \pre nivel >= 0
+    \post Se han añadido a os los procesadores P(num + 1)... en preorden, con memorias
+    aleatorias, y num es el último número usado
+*/
+static void generar_arbol(ostringstream& os, int& num, int nivel, int max) {
+    if (num >= max or (nivel > 0 and azar(0, 9) < 3)) os << "* ";
+    else {
+        ++num;
+        os << 'P' << num << ' ' << azar(4, 120) << ' ';
+        generar_arbol(os, num, nivel + 1, max);
+        generar_arbol(os, num, nivel + 1, max);
+    }
+}
+
+/** @brief Genera un cluster aleatorio para la traza t
+
+    \pre <em>cierto</em>
+    \post t.arbol y t.nprc describen un cluster aleatorio de como mucho 31 procesadores
+*/
+static void generar_cluster(Traza& t) {
+    ostringstream os;
+    int num = 0;
+    generar_arbol(os, num, 0, azar(1, 31));
+    t.arbol = os.str();
+    t.nprc = num;
+}
+
+/** @brief Genera un comando aleatorio
+
+    \pre t.nprc > 0
+    \post El resultado es un comando válido sintácticamente sobre los procesadores de t
+*/
+static string generar_comando(const Traza& t) {
+    ostringstream os;
+    string prc = "P" + to_string(azar(1, t.nprc));
+    string pri = PRIOR[azar(0, 2)];
+    int id = azar(1, 200);          //pocos ids: también se buscan colisiones
+    int r = azar(0, 99);
+    if (r < 30) os << "ape " << pri << ' ' << id << ' ' << azar(1, 60) << ' ' << azar(1, 20);
+    else if (r < 42) os << "app " << prc << ' ' << id << ' ' << azar(1, 60) << ' ' << azar(1, 20);
+    else if (r < 50) os << "bpp " << prc << ' ' << id;
+    else if (r < 64) os << "epc " << azar(1, 40);
+    else if (r < 76) os << "at " << azar(1, 10);
+    else if (r < 81) os << "cmp " << prc;
+    else if (r < 84) os << "cmc";
+    else if (r < 92) {
+        int k = azar(1, 16);
+        os << "apes " << pri << ' ' << k;
+        for (int i = 0; i < k; ++i) os << ' ' << azar(1, 200) << ' ' << azar(1, 60) << ' ' << azar(1, 20);
+    }
+    else if (r < 96) {
+        int k = azar(1, 16);
+        os << "apps " << prc << ' ' << k;
+        for (int i = 0; i < k; ++i) os << ' ' << azar(1, 200) << ' ' << azar(1, 60) << ' ' << azar(1, 20);
+    }
+    else {
+        int k = azar(1, 8);
+        os << "bpps " << prc << ' ' << k;
+        for (int i = 0; i < k; ++i) os << ' ' << azar(1, 200);
+    }
+    return os.str();
+}
+
+/** @brief Cambia un argumento numérico de un comando
+
+    \pre <em>cierto</em>
+    \post El resultado es c con uno de sus números multiplicado, dividido o
+    desplazado un poco (memorias y tiempos ajustados para forzar huecos concretos)
+*/
+static string ajustar(const string& c) {
+    istringstream is(c);
+    vector<string> w;
+    string x;
+    while (is >> x) w.push_back(x);
+    vector<int> num;            //posiciones numéricas que no son contadores de bloque
+    for (int i = 1; i < w.size(); ++i) {
+        if (isdigit(w[i][0]) and not ((w[0] == "apes" or w[0] == "apps" or w[0] == "bpps") and i == 2)) num.push_back(i);
+    }
+    if (num.empty()) return c;
+    int i = num[azar(0, num.size() - 1)];
+    int v = atoi(w[i].c_str());
+    int r = azar(0, 3);
+    if (r == 0) v *= 2;
+    else if (r == 1) v /= 2;
+    else v += azar(-3, 3);
+    if (v < 1) v = 1;
+    w[i] = to_string(v);
+    string res = w[0];
+    for (int j = 1; j < w.size(); ++j) res += ' ' + w[j];
+    return res;
+}
+
+/** @brief Texto completo de una traza, listo para program.exe */
+static string texto(const Traza& t) {
+    ostringstream os;
+    os << t.arbol << '\n' << 3 << ' ' << PRIOR[0] << ' ' << PRIOR[1] << ' ' << PRIOR[2] << '\n';
+    for (int i = 0; i < t.cmds.size(); ++i) os << t.cmds[i] << '\n';
+    os << "fin\n";
+    return os.str();
+}
+
+/** @brief Ejecuta una traza y calcula su coste
+
+    \pre <em>cierto</em>
+    \post t.coste es el coste de ejecutar t (contadores o microsegundos si tiempo)
+    y t.contadores los contadores de la ejecución
+*/
+static void evaluar(Traza& t, bool tiempo) {
+    istringstream in(texto(t));
+    Descarte nulo;
+    streambuf* cin_ant = cin.rdbuf(in.rdbuf());
+    streambuf* cout_ant = cout.rdbuf(&nulo);
+    Contadores::reiniciar();
+    chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+    {
+        Federacion f;
+        f.leer();
+        procesar_comandos(f);
+    }
+    long long us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - ini).count();
+    cin.rdbuf(cin_ant);
+    cout.rdbuf(cout_ant);
+    cin.clear();
+    t.coste = tiempo ? us : Contadores::total();
+    ostringstream os;
+    Contadores::escribir(os);
+    t.contadores = os.str();
+}
+
+/** @brief Crea un descendiente
+
+    \pre a y b tienen al menos un comando
+    \post El resultado es a con una mutación aleatoria (cambio, inserción, borrado,
+    duplicado de un tramo, ajuste numérico, nuevo cluster) o cruzado con b, con
+    como mucho max comandos
+*/
+static Traza mutar(const Traza& a, const Traza& b, int max) {
+    Traza t = a;
+    int n = t.cmds.size();
+    int r = azar(0, 6);
+    if (r == 0) t.cmds[azar(0, n - 1)] = generar_comando(t);
+    else if (r == 1) t.cmds.insert(t.cmds.begin() + azar(0, n), generar_comando(t));
+    else if (r == 2 and n > 1) t.cmds.erase(t.cmds.begin() + azar(0, n - 1));
+    else if (r == 3) {          //repetir un tramo alarga los ciclos de reencolado y los patrones de huecos
+        int i = azar(0, n - 1);
+        int j = azar(i, min(n - 1, i + 20));
+        vector<string> tramo(t.cmds.begin() + i, t.cmds.begin() + j + 1);
+        t.cmds.insert(t.cmds.begin() + azar(0, n), tramo.begin(), tramo.end());
+    }
+    else if (r == 4) {
+        int i = azar(0, n - 1);
+        t.cmds[i] = ajustar(t.cmds[i]);
+    }
+    else if (r == 5) {          //cruce: principio de a y final de b
+        int i = azar(0, n);
+        int j = azar(0, b.cmds.size());
+        t.cmds.resize(i);
+        t.cmds.insert(t.cmds.end(), b.cmds.begin() + j, b.cmds.end());
+        if (t.cmds.empty()) t.cmds.push_back(generar_comando(t));
+    }
+    else generar_cluster(t);
+    if (t.cmds.size() > max) t.cmds.resize(max);
+    return t;
+}
+
+/** @brief Orden de la población: primero las trazas más costosas */
+static bool mas_costosa(const Traza& a, const Traza& b) {
+    return a.coste > b.coste;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int semilla = 1;
+    int generaciones = 200, poblacion = 16, max = 400, guardar = 3;
+    string prefijo = "peor";
+    bool tiempo = false;
+    for (int i = 1; i < argc; ++i) {
+        string op = argv[i];
+        if (op == "-t") tiempo = true;
+        else if (i + 1 < argc and op == "-s") semilla = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-g") generaciones = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-p") poblacion = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-n") max = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-k") guardar = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-o") prefijo = argv[++i];
+        else {
+            cerr << "uso: " << argv[0] << " [-s semilla] [-g generaciones] [-p poblacion] [-n comandos] [-k guardadas] [-o prefijo] [-t]" << endl;
+            return 1;
+        }
+    }
+    if (poblacion < 2) poblacion = 2;
+    if (max < 1) max = 1;
+    gen.seed(semilla);
+
+    vector<Traza> pob(poblacion);
+    for (int i = 0; i < poblacion; ++i) {
+        generar_cluster(pob[i]);
+        int n = azar(1, max);
+        for (int j = 0; j < n; ++j) pob[i].cmds.push_back(generar_comando(pob[i]));
+        evaluar(pob[i], tiempo);
+    }
+    sort(pob.begin(), pob.end(), mas_costosa);
+    for (int g = 0; g < generaciones; ++g) {
+        //torneo de dos para cada progenitor; la población siguiente son las mejores de padres e hijos
+        for (int i = 0; i < poblacion; ++i) {
+            int a = min(azar(0, poblacion - 1), azar(0, poblacion - 1));
+            int b = min(azar(0, poblacion - 1), azar(0, poblacion - 1));
+            Traza t = mutar(pob[a], pob[b], max);
+            evaluar(t, tiempo);
+            pob.push_back(t);
+        }
+        stable_sort(pob.begin(), pob.end(), mas_costosa);
+        pob.resize(poblacion);
+        cerr << "generacion " << g + 1 << ": " << pob[0].coste << endl;
+    }
+
+    if (guardar > poblacion) guardar = poblacion;
+    for (int i = 0; i < guardar; ++i) {
+        string fich = prefijo + to_string(i + 1) + ".txt";
+        ofstream out(fich.c_str());
+        out << texto(pob[i]);
+        if (not out) {
+            cerr << "error: no se puede escribir " << fich << endl;
+            return 1;
+        }
+        cout << fich << ' ' << pob[i].coste << ' ' << pob[i].contadores;
+    }
+}
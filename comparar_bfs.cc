@@ -0,0 +1,113 @@
+/** @file comparar_bfs.cc
+    @brief Comparación de la búsqueda de procesador con y sin la tabla de huecos
+
+    Uso: <em>comparar_bfs.exe [-n procesadores_max] [-k procesos] [-r repeticiones]</em>
+
+    Para n = 1000, 10000, ... hasta el máximo, crea un cluster equilibrado de n
+    procesadores con procesos que dejan huecos de tamaños variados, pone k
+    procesos en espera (la mayoría sólo caben en pocos procesadores) y mide el
+    tiempo del epc que los envía, una vez con bfs recorriendo los procesadores uno
+    a uno (mth 0) y otra recorriendo la tabla de huecos (mth 1), cada uno sobre una
+    federación nueva con el mismo estado. La preparación no se mide. Repite cada
+    medida r veces y se queda con la menor. Escribe por cada n los microsegundos
+    de cada recorrido, la aceleración y si las dos salidas son iguales.
+*/
+
+#include "Federacion.hh"
+#include "Comandos.hh"
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+/** @brief Memoria de cada procesador */
+static const int MEMORIA = 1000;
+
+/** @brief Genera un subárbol equilibrado con los procesadores P(num + 1)... P(num + n) en preorden */
+static void generar_arbol(ostringstream& os, int& num, int n) {
+    if (n == 0) os << "* ";
+    else {
+        ++num;
+        os << 'P' << num << ' ' << MEMORIA << ' ';
+        int izq = (n - 1) / 2;
+        generar_arbol(os, num, izq);
+        generar_arbol(os, num, n - 1 - izq);
+    }
+}
+
+/** @brief Siguiente valor de un generador congruencial (determinista en todas las máquinas) */
+static unsigned siguiente(unsigned& x) {
+    x = x * 1103515245u + 12345u;
+    return x >> 8;
+}
+
+/** @brief Ejecuta comandos sobre f con la salida en os y devuelve los microsegundos que tarda */
+static long long ejecutar(Federacion& f, const string& comandos, ostream& os) {
+    istringstream in(comandos + "fin\n");
+    streambuf* cin_ant = cin.rdbuf(in.rdbuf());
+    streambuf* cout_ant = cout.rdbuf(os.rdbuf());
+    chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+    procesar_comandos(f);
+    long long us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - ini).count();
+    cin.rdbuf(cin_ant);
+    cout.rdbuf(cout_ant);
+    cin.clear();
+    return us;
+}
+
+/** @brief Mide el epc con un recorrido; deja su salida en salida */
+static long long medir(const string& cluster, const string& preparar, const string& operar, bool tabla, string& salida) {
+    istringstream in(cluster + "\n1 a\n");
+    streambuf* cin_ant = cin.rdbuf(in.rdbuf());
+    Federacion f;
+    f.leer();
+    cin.rdbuf(cin_ant);
+    ostringstream nulo, os;
+    ejecutar(f, preparar + (tabla ? "mth 1\n" : "mth 0\n"), nulo);
+    long long us = ejecutar(f, operar, os);
+    salida = os.str();
+    return us;
+}
+
+int main(int argc, char* argv[]) {
+    int tope = 1000000, k = 1000, r = 3;
+    for (int i = 1; i < argc; ++i) {
+        string op = argv[i];
+        if (i + 1 < argc and op == "-n") tope = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-k") k = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-r") r = atoi(argv[++i]);
+        else {
+            cerr << "uso: " << argv[0] << " [-n procesadores_max] [-k procesos] [-r repeticiones]" << endl;
+            return 1;
+        }
+    }
+    if (k < 1) k = 1;
+    if (r < 1) r = 1;
+    cout << "procesadores procesos us_procesadores us_tabla aceleracion iguales" << endl;
+    for (int n = 1000; n <= tope; n *= 10) {
+        ostringstream cl, pre, op;
+        int num = 0;
+        generar_arbol(cl, num, n);
+        unsigned x = n;
+        for (int i = 1; i <= n; ++i) {      //hueco final de 0 a 255 y en uno de cada cuatro, un hueco inicial pequeño
+            int a = 1 + siguiente(x) % 64;
+            pre << "app P" << i << " 1 " << a << " 1000000\n"
+                << "app P" << i << " 2 " << MEMORIA - a - siguiente(x) % 256 << " 1000000\n";
+            if (siguiente(x) % 4 == 0) pre << "bpp P" << i << " 1\n";
+        }
+        for (int i = 1; i <= k; ++i) pre << "ape a " << 2 + i << ' ' << 64 + siguiente(x) % 192 << " 1000000\n";
+        op << "epc " << k << '\n';
+        long long us[2];
+        string salida[2];
+        for (int t = 0; t < 2; ++t) {
+            us[t] = -1;
+            for (int j = 0; j < r; ++j) {
+                long long u = medir(cl.str(), pre.str(), op.str(), t == 1, salida[t]);
+                if (us[t] == -1 or u < us[t]) us[t] = u;
+            }
+        }
+        cout << n << ' ' << k << ' ' << us[0] << ' ' << us[1] << ' ' << double(us[0]) / max(us[1], 1LL)
+             << ' ' << (salida[0] == salida[1] ? "si" : "no") << endl;
+    }
+}
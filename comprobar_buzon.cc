@@ -0,0 +1,103 @@
+/** @file comprobar_buzon.cc
+    @brief Prueba de carga y medida del buzón con varios productores
+
+    Uso: <em>comprobar_buzon.exe [-p productores_max] [-n peticiones]</em>
+
+    Para p = 1, 2, 4, ... hasta el máximo, p hilos depositan cada uno n altas de
+    proceso en un buzón (las del productor q tienen ids q * n, q * n + 1, ... en ese
+    orden) mientras el hilo principal lo vacía por lotes sobre un área de espera,
+    como hace la simulación entre comando y comando. Con las cabeceras que escribe
+    drenar() comprueba que cada petición se aplica exactamente una vez y que las de
+    cada productor se aplican en el orden en el que las depositó.
+    Escribe por cada p los microsegundos que tardan los productores en depositarlo
+    todo, las peticiones depositadas por segundo, los microsegundos hasta aplicarlo
+    todo y si la comprobación es correcta; acaba con código 1 si alguna falla.
+    Con menos núcleos que hilos, productores y consumidor se reparten el tiempo:
+    la medida es de depósito con reparto de tiempo, no de paralelismo real.
+*/
+
+#include "Buzon.hh"
+#include "Area_espera.hh"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+/** @brief Deposita n altas de proceso con ids q * n, q * n + 1, ... cuando salida es cierto */
+static void producir(Buzon& b, int q, int n, const atomic<bool>& salida) {
+    while (not salida.load(memory_order_acquire)) this_thread::yield();
+    for (int i = 0; i < n; ++i) b.alta_proceso(Proceso(q * n + i, 1, 1), "a");
+}
+
+/** @brief Comprueba la salida de drenar(): p * n cabeceras "#ape a id", en orden por productor */
+static bool comprobar(const string& salida, int p, int n) {
+    istringstream in(salida);
+    vector<int> sig(p, 0);          //siguiente secuencia esperada de cada productor
+    string cabecera, prior;
+    int id, total = 0;
+    while (in >> cabecera >> prior >> id) {
+        if (cabecera != "#ape" or prior != "a" or id < 0 or id >= p * n) return false;
+        int q = id / n;
+        if (id % n != sig[q]) return false;
+        ++sig[q];
+        ++total;
+    }
+    return in.eof() and total == p * n;
+}
+
+int main(int argc, char* argv[]) {
+    int tope = 32, n = 20000;
+    for (int i = 1; i < argc; ++i) {
+        string op = argv[i];
+        if (i + 1 < argc and op == "-p") tope = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-n") n = atoi(argv[++i]);
+        else {
+            cerr << "uso: " << argv[0] << " [-p productores_max] [-n peticiones]" << endl;
+            return 1;
+        }
+    }
+    if (n < 1) n = 1;
+    bool fallo = false;
+    cout << "productores peticiones us_deposito peticiones_por_s us_total correcto" << endl;
+    for (int p = 1; p <= tope; p *= 2) {
+        Buzon b;
+        Area_espera ae;
+        ae.add_prior("a");
+        atomic<bool> salida(false);
+        atomic<int> acabados(0);
+        vector<thread> hilos;
+        long long us_deposito = 0;
+        for (int q = 0; q < p; ++q) {
+            hilos.push_back(thread([&b, q, n, &salida, &acabados]() {
+                producir(b, q, n, salida);
+                acabados.fetch_add(1, memory_order_release);
+            }));
+        }
+        ostringstream os;
+        streambuf* cout_ant = cout.rdbuf(os.rdbuf());
+        chrono::steady_clock::time_point ini = chrono::steady_clock::now();
+        salida.store(true, memory_order_release);
+        int aplicadas = 0;
+        while (aplicadas < p * n) {
+            int k = b.drenar(ae, 0, 1024);
+            if (us_deposito == 0 and acabados.load(memory_order_acquire) == p) {
+                us_deposito = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - ini).count();
+            }
+            if (k == 0) this_thread::yield();
+            aplicadas += k;
+        }
+        long long us_total = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - ini).count();
+        if (us_deposito == 0) us_deposito = us_total;
+        cout.rdbuf(cout_ant);
+        for (int q = 0; q < p; ++q) hilos[q].join();
+        bool correcto = comprobar(os.str(), p, n);
+        if (not correcto) fallo = true;
+        cout << p << ' ' << (long long)p * n << ' ' << us_deposito << ' '
+             << (long long)((double)p * n * 1e6 / max(us_deposito, 1LL)) << ' ' << us_total << ' '
+             << (correcto ? "si" : "no") << endl;
+    }
+    return fallo ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+/** @file comprobar_coste.cc
+    @brief Comprobación del coste declarado de las operaciones con los contadores de operaciones
+
+    Uso: <em>comprobar_coste.exe [-n tamaño_maximo] [-k repeticiones]</em>
+
+    Para cada operación comprobada ejecuta sobre una federación nueva una traza que
+    prepara un estado de tamaño n (procesos en un procesador, procesadores en el
+    cluster o procesos en espera) y repite después k veces la operación, para
+    n = 64, 128, ... hasta el tamaño máximo. El trabajo de la operación es la
+    diferencia de la suma de los contadores de operaciones (consultar la clase
+    Contadores) entre la traza completa y la de preparación sola, dividida por k;
+    es determinista e independiente de la máquina.
+    Se ajusta por mínimos cuadrados la pendiente de log(trabajo) respecto a log(n) y
+    se compara con el exponente del coste declarado en la especificación (0 para
+    constante y logarítmico, porque los contadores cuentan elementos recorridos y no
+    comparaciones, 1 para lineal) más un margen. Escribe una línea por operación en
+    el canal standard de salida y acaba con código 1 si alguna supera su coste.
+*/
+
+#include "Federacion.hh"
+#include "Comandos.hh"
+#include "Contadores.hh"
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+/** @brief Canal de salida que descarta todo lo que se escribe */
+class Descarte : public streambuf {
+protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+/** @brief Traza de una medida: preparación y operación repetida */
+struct Medida {
+    string cluster;             //cluster en el formato de leer() de Cluster
+    string preparar;            //comandos que crean el estado de tamaño n
+    string operar;              //k repeticiones de la operación medida
+};
+
+/** @brief Operación comprobada */
+struct Operacion {
+    const char* nombre;
+    const char* declarado;      //coste declarado en la especificación
+    double exponente;           //exponente del coste declarado respecto a n
+    Medida (*generar)(int n, int k);
+};
+
+/** @brief Margen sobre el exponente declarado antes de dar la operación por fallida */
+static const double MARGEN = 0.3;
+
+/** @brief Memoria de un procesador en el que caben n procesos de memoria 1 con holgura */
+static int memoria(int n) {
+    return 4 * n + 64;
+}
+
+/** @brief Añade a os n procesos de memoria 1 y tiempo largo en el procesador P1, con ids 1..n */
+static void llenar(ostringstream& os, int n) {
+    for (int i = 1; i <= n; ++i) os << "app P1 " << i << " 1 1000000\n";
+}
+
+/** @brief Genera un subárbol equilibrado con los procesadores P(num + 1)... P(num + n) en preorden */
+static void generar_arbol(ostringstream& os, int& num, int n, int mem) {
+    if (n == 0) os << "* ";
+    else {
+        ++num;
+        os << 'P' << num << ' ' << mem << ' ';
+        int izq = (n - 1) / 2;
+        generar_arbol(os, num, izq, mem);
+        generar_arbol(os, num, n - 1 - izq, mem);
+    }
+}
+
+/** @brief add_job (app) en un procesador con n procesos */
+static Medida medir_add_job(int n, int k) {
+    Medida m;
+    m.cluster = "P1 " + to_string(memoria(n + k)) + " * *";
+    ostringstream pre, op;
+    llenar(pre, n);
+    for (int i = 1; i <= k; ++i) op << "app P1 " << n + i << " 1 1000000\n";
+    m.preparar = pre.str();
+    m.operar = op.str();
+    return m;
+}
+
+/** @brief eliminar_job (bpp) en un procesador con n procesos */
+static Medida medir_eliminar_job(int n, int k) {
+    Medida m;
+    m.cluster = "P1 " + to_string(memoria(n)) + " * *";
+    ostringstream pre, op;
+    llenar(pre, n);
+    for (int i = 0; i < k; ++i) op << "bpp P1 " << 1 + (long long)i * n / k << '\n';    //repartidos por la memoria
+    m.preparar = pre.str();
+    m.operar = op.str();
+    return m;
+}
+
+/** @brief compactar_mem (cmp) en un procesador con n procesos separados por huecos */
+static Medida medir_compactar_mem(int n, int k) {
+    Medida m;
+    m.cluster = "P1 " + to_string(memoria(2 * n)) + " * *";
+    ostringstream pre, op;
+    llenar(pre, 2 * n);
+    for (int i = 2; i <= 2 * n; i += 2) pre << "bpp P1 " << i << '\n';
+    for (int i = 0; i < k; ++i) op << "cmp P1\n";
+    m.preparar = pre.str();
+    m.operar = op.str();
+    return m;
+}
+
+/** @brief avanzar_tiempo (at) en un procesador con n procesos sin acabar */
+static Medida medir_avanzar_tiempo(int n, int k) {
+    Medida m;
+    m.cluster = "P1 " + to_string(memoria(n)) + " * *";
+    ostringstream pre, op;
+    llenar(pre, n);
+    for (int i = 0; i < k; ++i) op << "at 1\n";
+    m.preparar = pre.str();
+    m.operar = op.str();
+    return m;
+}
+
+/** @brief Búsqueda de procesador (epc que coloca k procesos) en un cluster de n procesadores */
+static Medida medir_bfs(int n, int k) {
+    Medida m;
+    ostringstream cl, pre, op;
+    int num = 0;
+    generar_arbol(cl, num, n, memoria(k));
+    m.cluster = cl.str();
+    for (int i = 1; i <= k; ++i) pre << "ape a " << i << " 1 1000000\n";
+    op << "epc " << k << '\n';
+    m.preparar = pre.str();
+    m.operar = op.str();
+    return m;
+}
+
+/** @brief Reencolado (epc sin ningún proceso que quepa, recorre y reencola toda la espera) con n procesos en espera */
+static Medida medir_reencolado(int n, int k) {
+    Medida m;
+    m.cluster = "P1 8 * *";
+    ostringstream pre, op;
+    for (int i = 1; i <= n; ++i) pre << "ape a " << i << " 16 10\n";
+    for (int i = 0; i < k; ++i) op << "epc 1\n";
+    m.preparar = pre.str();
+    m.operar = op.str();
+    return m;
+}
+
+/** @brief Operaciones comprobadas, con el coste de su especificación */
+static const Operacion OPERACIONES[] = {
+    {"Procesador::add_job", "Logarítmico más los procesos desplazados", 1, medir_add_job},
+    {"Procesador::eliminar_job", "Logarítmico más los procesos desplazados", 1, medir_eliminar_job},
+    {"Procesador::compactar_mem", "Lineal", 1, medir_compactar_mem},
+    {"Procesador::avanzar_tiempo", "Lineal", 1, medir_avanzar_tiempo},
+    {"Cluster::recibir_job", "Lineal", 1, medir_bfs},
+    {"Prioridad::enviar_proceso", "Lineal sobre lineal", 1, medir_reencolado},
+};
+
+/** @brief Ejecuta una traza y devuelve la suma de los contadores de operaciones */
+static long long ejecutar(const string& cluster, const string& comandos) {
+    istringstream in(cluster + "\n1 a\n" + comandos + "fin\n");
+    Descarte nulo;
+    streambuf* cin_ant = cin.rdbuf(in.rdbuf());
+    streambuf* cout_ant = cout.rdbuf(&nulo);
+    Contadores::reiniciar();
+    {
+        Federacion f;
+        f.leer();
+        procesar_comandos(f);
+    }
+    cin.rdbuf(cin_ant);
+    cout.rdbuf(cout_ant);
+    cin.clear();
+    return Contadores::total();
+}
+
+/** @brief Pendiente por mínimos cuadrados de y respecto a x */
+static double pendiente(const vector<double>& x, const vector<double>& y) {
+    int n = x.size();
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = 0; i < n; ++i) {
+        sx += x[i];
+        sy += y[i];
+        sxx += x[i] * x[i];
+        sxy += x[i] * y[i];
+    }
+    return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+int main(int argc, char* argv[]) {
+    int tope = 4096, k = 16;
+    for (int i = 1; i < argc; ++i) {
+        string op = argv[i];
+        if (i + 1 < argc and op == "-n") tope = atoi(argv[++i]);
+        else if (i + 1 < argc and op == "-k") k = atoi(argv[++i]);
+        else {
+            cerr << "uso: " << argv[0] << " [-n tamaño_maximo] [-k repeticiones]" << endl;
+            return 1;
+        }
+    }
+    if (tope < 256) tope = 256;   //al menos tres tamaños para ajustar la pendiente
+    if (k < 1) k = 1;
+
+    int fallos = 0;
+    for (const Operacion& o : OPERACIONES) {
+        vector<double> x, y;
+        cout << o.nombre << " (" << o.declarado << "):";
+        for (int n = 64; n <= tope; n *= 2) {
+            Medida m = o.generar(n, k);
+            long long trabajo = ejecutar(m.cluster, m.preparar + m.operar) - ejecutar(m.cluster, m.preparar);
+            double c = max(1.0, double(trabajo) / k);      //sin trabajo cuenta como constante
+            cout << ' ' << n << '=' << c;
+            x.push_back(log2(double(n)));
+            y.push_back(log2(c));
+        }
+        double p = pendiente(x, y);
+        bool ok = p <= o.exponente + MARGEN;
+        if (not ok) ++fallos;
+        cout << " pendiente " << p << (ok ? " ok" : " supera") << endl;
+    }
+    if (fallos > 0) return 1;
+}
@@ -0,0 +1,38 @@
+/** @file comprobar_invariantes.cc
+    @brief Comprobación de los invariantes de la simulación tras cada comando
+
+    Uso: <em>comprobar_invariantes.exe < entrada</em>
+
+    Lee la configuración inicial y los comandos del canal standard de entrada como
+    program.exe y escribe la misma salida en el canal standard de salida. Después
+    de cada comando comprueba los invariantes del cluster y del área de espera
+    seleccionados (consultar comprobar_invariantes() de las clases Cluster y
+    Area_espera) y escribe en el canal standard de errores cada invariante que no
+    se cumple, precedido del número y el nombre del comando. Acaba con código 1 si
+    alguno ha fallado; si no, con código 0.
+*/
+
+#include "Federacion.hh"
+#include "Comandos.hh"
+#include <sstream>
+
+using namespace std;
+
+int main() {
+    Federacion f;
+    f.leer();
+    int fallos = 0;
+    int num = 0;
+    procesar_comandos(f, nullptr, [&fallos, &num](Federacion& f, const string& comando) {
+        ++num;
+        ostringstream os;       //los errores de invariante no se mezclan con la salida
+        streambuf* salida = cout.rdbuf(os.rdbuf());
+        int n = f.cluster().comprobar_invariantes() + f.espera().comprobar_invariantes();
+        cout.rdbuf(salida);
+        if (n > 0) {
+            cerr << "comando " << num << ' ' << comando << endl << os.str();
+            fallos += n;
+        }
+    });
+    return fallos > 0 ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+/** @file comprobar_registro.cc
+    @brief Comprobación de un registro de eventos contra la salida de la simulación
+
+    Uso: <em>comprobar_registro.exe registro salida</em>
+
+    Reproduce en orden los eventos del registro (consultar la clase Registro):
+    "coloca" pone el proceso en su posición del procesador, "acaba" y "elimina" lo
+    quitan y "mueve" lo cambia de posición, comprobando que cada evento es posible
+    (la posición está libre, el proceso está donde dice el evento...). Después
+    compara el contenido de cada procesador con el del último "#ipc" de la salida
+    (pares posición y proceso). Escribe la primera diferencia y acaba con código 1
+    si hay alguna; si no, acaba con código 0 sin escribir nada.
+*/
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** @brief Contenido de cada procesador: posición -> proceso */
+typedef map<string, map<int, int> > Contenido;
+
+/** @brief Escribe un error sobre la línea l del fichero fich y devuelve falso */
+static bool fallo(const string& fich, int l, const string& que) {
+    cout << fich << ':' << l << ": " << que << endl;
+    return false;
+}
+
+/** @brief Reproduce el registro fich sobre c; devuelve si todos los eventos son posibles */
+static bool reproducir(const string& fich, Contenido& c) {
+    ifstream in(fich.c_str());
+    if (not in) return fallo(fich, 0, "no se puede abrir");
+    string linea;
+    int l = 0;
+    while (getline(in, linea)) {
+        ++l;
+        istringstream is(linea);
+        int t, job;
+        string tipo, prc;
+        if (not (is >> t >> tipo >> prc >> job)) return fallo(fich, l, "linea incorrecta");
+        map<int, int>& m = c[prc];
+        if (tipo == "coloca") {
+            int pos;
+            if (not (is >> pos)) return fallo(fich, l, "linea incorrecta");
+            if (not m.insert(make_pair(pos, job)).second) return fallo(fich, l, "posicion ocupada");
+        }
+        else if (tipo == "acaba" or tipo == "elimina") {
+            map<int, int>::iterator it = m.begin();
+            while (it != m.end() and it->second != job) ++it;
+            if (it == m.end()) return fallo(fich, l, "proceso inexistente");
+            m.erase(it);
+        }
+        else if (tipo == "mueve") {
+            int desde, hasta;
+            if (not (is >> desde >> hasta)) return fallo(fich, l, "linea incorrecta");
+            map<int, int>::iterator it = m.find(desde);
+            if (it == m.end() or it->second != job) return fallo(fich, l, "proceso fuera de su posicion");
+            m.erase(it);
+            if (not m.insert(make_pair(hasta, job)).second) return fallo(fich, l, "posicion ocupada");
+        }
+        else return fallo(fich, l, "evento desconocido");
+    }
+    return true;
+}
+
+/** @brief Lee en c el último "#ipc" de la salida fich; devuelve si lo hay */
+static bool leer_ipc(const string& fich, Contenido& c) {
+    ifstream in(fich.c_str());
+    if (not in) return fallo(fich, 0, "no se puede abrir");
+    vector<string> lineas;
+    string linea;
+    int ini = -1;
+    while (getline(in, linea)) {
+        if (linea == "#ipc" or linea == "#imprimir_procesadores_cluster") ini = lineas.size() + 1;
+        lineas.push_back(linea);
+    }
+    if (ini == -1) return fallo(fich, 0, "sin #ipc");
+    string prc;
+    for (int i = ini; i < lineas.size() and (lineas[i].empty() or lineas[i][0] != '#'); ++i) {
+        istringstream is(lineas[i]);
+        int pos, job;
+        if (is >> pos >> job) c[prc][pos] = job;
+        else {
+            prc = lineas[i];
+            c[prc];
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "uso: " << argv[0] << " registro salida" << endl;
+        return 1;
+    }
+    Contenido reg, ipc;
+    if (not reproducir(argv[1], reg) or not leer_ipc(argv[2], ipc)) return 1;
+    for (Contenido::const_iterator it = ipc.begin(); it != ipc.end(); ++it) {
+        Contenido::const_iterator r = reg.find(it->first);
+        bool vacio = (r == reg.end() or r->second.empty());
+        if ((vacio and not it->second.empty()) or (not vacio and r->second != it->second)) {
+            cout << argv[1] << ": " << it->first << " no coincide con " << argv[2] << endl;
+            return 1;
+        }
+    }
+    for (Contenido::const_iterator r = reg.begin(); r != reg.end(); ++r) {
+        if (not r->second.empty() and ipc.count(r->first) == 0) {
+            cout << argv[1] << ": " << r->first << " no aparece en " << argv[2] << endl;
+            return 1;
+        }
+    }
+}
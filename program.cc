@@ -16,126 +16,157 @@ Sólo se documentan los elementos públicos.
 #include "Cluster.hh"
 #include "Area_espera.hh"
 #include "Prioridad.hh"
+#include "Buzon.hh"
+#include "Federacion.hh"
+#include "Comandos.hh"
+#include <fstream>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using namespace std;
 
-/** @brief Programa principal para el proyecto <em>Simulación del rendimiento de procesadores interconectados</em>
+/** @brief Ejecuta un escenario en un proceso hijo
+
+    \pre f contiene la configuración inicial compartida
+    \post Se ha creado un proceso hijo que ejecuta los comandos del fichero fich sobre
+    su propia copia de f y escribe la salida en fich.out; devuelve su pid, -1 si
+    no se ha podido crear
 */
-int main() {
-    Cluster c;
-    c.leer();
-    Area_espera ae;
-    ae.leer();
-    string comando;
-    cin >> comando;
-    while (comando != "fin") {
-        if (comando == "cc" or comando == "configurar_cluster") {   //1
-            cout << '#' << comando << endl;
-            c.leer();  
-        }
-        else if (comando == "mc" or comando == "modificar_cluster") {        //2
-            string id;
-            cin >> id;
-            Cluster c2;
-            c2.leer();
-            cout << '#' << comando << ' ' << id << endl;
-            c.añadir_cluster(c2, id);         
-        }
+pid_t lanzar_escenario(const string& fich, Federacion& f) {
+    pid_t pid = fork();
+    if (pid == 0) {         //el hijo comparte la configuración inicial con el padre (copia en escritura)
+        ifstream in(fich.c_str());
+        if (not in) {
+            cerr << "error: no se puede abrir " << fich << endl;
+            _exit(1);
+        }
+        ofstream out((fich + ".out").c_str());
+        if (not out) {
+            cerr << "error: no se puede escribir " << fich << ".out" << endl;
+            _exit(1);
+        }
+        cin.rdbuf(in.rdbuf());
+        cout.rdbuf(out.rdbuf());
+        procesar_comandos(f);
+        cout.flush();           //los errores de escritura quedan en cout, que escribe en el buffer de out
+        _exit(cout ? 0 : 1);
+    }
+    return pid;
+}
 
-        else if (comando == "ap" or comando == "alta_prioridad") {         //3      
-            string id_prior;
-            cin >> id_prior;
-            cout << '#' << comando << ' ' << id_prior << endl;
-            ae.add_prior(id_prior);      
-        }
+/** @brief Deposita en un buzón las peticiones de un fichero
 
-        else if (comando == "bp" or comando == "baja_prioridad") {         //4   
-            string id_prior;
-            cin >> id_prior;
-            cout << '#' << comando << ' ' << id_prior << endl;   
-            ae.eliminar_prior(id_prior);     
-        }
-        
-        else if (comando == "ape" or comando == "alta_proceso_espera") {       //5  
-            string id_prior;
-            cin >> id_prior;
-            Proceso p;
-            p.leer();
-            cout << '#' << comando << ' ' << id_prior << ' ' << p.consultar_ID() << endl;     
-            ae.add_job(p, id_prior); 
-        }
-
-        else if (comando == "app" or comando == "alta_proceso_procesador") {        //6
-            string id;
-            cin >> id;
-            Proceso p;
-            p.leer();
-            cout << '#' << comando << ' ' << id << ' ' << p.consultar_ID() << endl;
-            c.add_job_prc(id, p);             
-        }
+    \pre b es el buzón que vacía la simulación
+    \post Se han depositado en b, en el orden del fichero fich, sus peticiones: líneas
+    <em>ape id_prior id mem tiempo</em>, <em>ap id_prior</em> o <em>bp id_prior</em>
+    (o con el nombre largo del comando); ok indica si se ha podido leer todo el
+    fichero (si no, se ha escrito un error en el canal standard de errores y las
+    peticiones a partir de la que falla no se depositan)
+*/
+void producir(const string& fich, Buzon& b, char& ok) {
+    ifstream in(fich.c_str());
+    ok = bool(in);
+    string comando, id_prior;
+    while (ok and in >> comando >> id_prior) {
+        if (comando == "ape" or comando == "alta_proceso_espera") {
+            int id, mem, tiempo;
+            ok = bool(in >> id >> mem >> tiempo);
+            if (ok) b.alta_proceso(Proceso(id, mem, tiempo), id_prior);
+        }
+        else if (comando == "ap" or comando == "alta_prioridad") b.alta_prioridad(id_prior);
+        else if (comando == "bp" or comando == "baja_prioridad") b.baja_prioridad(id_prior);
+        else ok = false;
+    }
+    if (ok and not in.eof()) ok = false;
+    if (not ok) cerr << "error: no se puede leer " << fich << endl;
+}
 
-        else if (comando == "bpp" or comando == "baja_proceso_procesador") {        //7
-            string idprc; //id procesador
-            int idjob;     //id proceso
-            cin >> idprc >> idjob;
-            cout << '#' << comando << ' ' << idprc << ' ' << idjob << endl;
-            c.eliminar_job_prc(idprc,idjob); 
-        }
+/** @brief Escribe cómo se usa el programa en el canal de errores
 
-        else if (comando == "epc" or comando == "enviar_procesos_cluster") {        //8
-            int n;
-            cin >> n;
-            cout << '#' << comando << ' ' << n << endl;
-            ae.enviar_job_a_cluster(n, c);   
-        }
+    \pre <em>cierto</em>
+    \post Se ha escrito el uso de prog en el canal standard de errores
+*/
+void escribir_uso(const char* prog) {
+    cerr << "uso: " << prog << " [[-j n] escenario... | -p peticiones...]" << endl;
+}
 
-        else if (comando == "at" or comando == "avanzar_tiempo") {     //9
-            int t;
-            cin >> t;
-            cout << '#' << comando << ' ' << t << endl;
-            c.avanzar_tiempo_prc(t);  
-        }
+/** @brief Programa principal para el proyecto <em>Simulación del rendimiento de procesadores interconectados</em>
 
-        else if (comando == "ipri" or comando == "imprimir_prioridad") {   //10 
-            string id_prior;
-            cin >> id_prior;
-            cout << '#' << comando << ' ' << id_prior << endl;
-            map <string, Prioridad>::const_iterator it;
-            ae.escribir_prior(id_prior, it);    
-        }
+    Sin argumentos lee la configuración inicial y los comandos del canal standard
+    de entrada. Con argumentos <em>[-j n] escenario...</em> lee sólo la configuración
+    inicial del canal standard de entrada y ejecuta cada fichero de escenario sobre
+    una copia propia de la federación, con como mucho n escenarios
+    a la vez (por defecto, uno por núcleo); la salida de cada escenario se escribe en
+    el fichero del escenario acabado en ".out". Con cualquier otro uso de -j (sin
+    número, con un número no positivo o sin escenarios) escribe el uso y acaba con
+    código 1 sin leer nada.
 
-        else if (comando == "iae" or comando == "imprimir_area_espera") {   //11
-            cout << '#' << comando << endl;
-            ae.escribir();  
-        }
-        else if (comando == "ipro" or comando == "imprimir_procesador") {   //12
-            string id;
-            cin >> id;
-            cout << '#' << comando << ' ' << id << endl;
-            map <string, Procesador>::const_iterator it;
-            c.escribir_prc(id, it);     
-        }
-        
-        else if (comando == "ipc" or comando == "imprimir_procesadores_cluster") {  //13
-            cout << '#' << comando << endl;
-            c.escribir_todos();   
-        }
-        else if (comando == "iec" or comando == "imprimir_estructura_cluster") {       //14
-            cout << '#' << comando << endl;
-            c.escribir_est(); 
-        }
-        else if (comando == "cmp" or comando == "compactar_memoria_procesador") {    //15
-            string id;
-            cin >> id; 
-            cout << '#' << comando << ' ' << id << endl;
-            c.compactar_prc(id);
-                  
-        }
-    
-        else if (comando == "cmc" or comando == "compactar_memoria_cluster") {      //16
-            cout << '#' << comando << endl;
-            c.compactar();   
-        }
-        cin >> comando;
+    Con <em>-p peticiones...</em> lee la configuración inicial y los comandos del
+    canal standard de entrada como sin argumentos, y además un hilo productor por
+    fichero de peticiones (consultar producir()) las deposita en un buzón que la
+    simulación vacía antes de cada comando (consultar procesar_comandos()); al
+    acabar los comandos espera a los productores y aplica las peticiones que
+    queden. Dónde se intercalan las peticiones de los productores entre los
+    comandos depende de la velocidad de cada hilo.
+*/
+int main(int argc, char* argv[]) {
+    int paralelos = sysconf(_SC_NPROCESSORS_ONLN);
+    int i = 1;
+    if (argc > 1 and string(argv[1]) == "-p") {
+        if (argc == 2) {
+            escribir_uso(argv[0]);
+            return 1;
+        }
+        Federacion f;
+        f.leer();
+        Buzon b;
+        vector<char> ok(argc - 2);
+        vector<thread> productores;
+        for (i = 2; i < argc; ++i) productores.push_back(thread(producir, string(argv[i]), ref(b), ref(ok[i - 2])));
+        procesar_comandos(f, &b);
+        for (int j = 0; j < productores.size(); ++j) productores[j].join();
+        while (b.drenar(f.espera(), f.cluster().consultar_tiempo(), 1024) > 0);
+        for (int j = 0; j < ok.size(); ++j) {
+            if (not ok[j]) return 1;
+        }
+        return 0;
+    }
+    if (argc > 1 and string(argv[1]) == "-j") {
+        char* fin = nullptr;
+        if (argc > 2) paralelos = strtol(argv[2], &fin, 10);
+        if (argc <= 3 or *fin != '\0' or fin == argv[2] or paralelos < 1) {
+            escribir_uso(argv[0]);
+            return 1;
+        }
+        i = 3;
+    }
+    Federacion f;
+    f.leer();
+    if (argc == 1) procesar_comandos(f);
+    else {
+        if (paralelos < 1) paralelos = 1;
+        cout.flush();
+        int activos = 0;
+        int fallos = 0;
+        for (; i < argc; ++i) {
+            if (activos == paralelos) {     //se espera a que acabe algún escenario
+                int estado;
+                if (wait(&estado) > 0 and not (WIFEXITED(estado) and WEXITSTATUS(estado) == 0)) ++fallos;
+                --activos;
+            }
+            if (lanzar_escenario(argv[i], f) == -1) {
+                cerr << "error: no se puede ejecutar " << argv[i] << endl;
+                ++fallos;
+            }
+            else ++activos;
+        }
+        while (activos > 0) {
+            int estado;
+            if (wait(&estado) > 0 and not (WIFEXITED(estado) and WEXITSTATUS(estado) == 0)) ++fallos;
+            --activos;
+        }
+        if (fallos > 0) return 1;
     }
 }